@@ -0,0 +1,201 @@
+#include "../Source/Util/LockStatistics.h"
+#include "../Source/World/Chunk/Chunk.h"
+#include "../Source/World/Chunk/ChunkAreaLock.h"
+#include "../Source/World/Chunk/FlatChunkMap.h"
+#include "../Source/World/Chunk/SectionSnapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures how long frames take while the chunk loader queues meshes, with
+ * one lock over the whole world against a lock per chunk.
+ *
+ * The render thread walks every chunk once per frame and edits a block, as
+ * World::renderWorld and the dig events do. The loader thread captures the
+ * sections of one chunk after another, as World::queueMesh does. With the
+ * world lock, a frame holds it for the whole walk and the loader for each
+ * chunk it captures, which is how World::m_mainMutex was used. With chunk
+ * locks, the render thread locks each chunk as it reaches it and the loader
+ * takes a ChunkAreaLock, so they only wait for each other on the same chunk.
+ *
+ * Run from the repository root, so the block data in Res/ is found.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int GRID = 24;
+constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+struct Result {
+    int frames = 0;
+    double meanFrameMs = 0;
+    double worstFrameMs = 0;
+    double capturesPerSecond = 0;
+    LockStatistics::Totals locks;
+};
+
+// Stone hills with a grass top, linked like the chunk storage links them
+void makeChunks(FlatChunkMap<Chunk> &chunks)
+{
+    for (int x = 0; x < GRID; x++)
+        for (int z = 0; z < GRID; z++) {
+            Chunk &chunk = *chunks.tryEmplace(x, z, sf::Vector2i(x, z)).first;
+            int height = 40 + (x * 7 + z * 13) % 24;
+            chunk.fillBox(0, 0, 0, CHUNK_SIZE, height, CHUNK_SIZE,
+                          BlockId::Stone);
+            chunk.fillLayer(height, BlockId::Grass);
+        }
+
+    for (int x = 0; x < GRID; x++)
+        for (int z = 0; z < GRID; z++) {
+            Chunk &chunk = *chunks.find(x, z);
+            const int offsets[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+            for (auto &offset : offsets) {
+                if (Chunk *other = chunks.find(x + offset[0], z + offset[1])) {
+                    chunk.linkNeighbour(offset[0], offset[1], *other);
+                }
+            }
+        }
+}
+
+// Reads a few blocks of every section, standing in for the draw calls
+int drawChunk(const Chunk &chunk)
+{
+    int visible = 0;
+    for (int index = 0; ChunkSection *section = chunk.findSection(index);
+         index++) {
+        for (int i = 0; i < 64; i++) {
+            visible += section->getBlock(i % CHUNK_SIZE, i / 4, i / 8) !=
+                       BlockId::Air;
+        }
+    }
+    return visible;
+}
+
+Result run(FlatChunkMap<Chunk> &chunks, bool isWorldLocked)
+{
+    LockStatistics worldLockStatistics;
+    CountedSharedMutex worldLock(worldLockStatistics);
+    Chunk::takeLockStatistics();
+
+    std::vector<Chunk *> order;
+    chunks.forEach([&](Chunk &chunk) { order.push_back(&chunk); });
+
+    std::atomic<bool> isRunning{true};
+    std::atomic<long long> captures{0};
+
+    std::thread loader([&] {
+        SectionSnapshot snapshot;
+        std::size_t next = 0;
+        while (isRunning) {
+            Chunk &chunk = *order[next++ % order.size()];
+
+            std::unique_lock<CountedSharedMutex> lock(worldLock,
+                                                      std::defer_lock);
+            std::optional<ChunkAreaLock> areaLock;
+            if (isWorldLocked) {
+                lock.lock();
+            }
+            else {
+                areaLock.emplace(chunk);
+            }
+
+            for (int index = 0; ChunkSection *section = chunk.findSection(index);
+                 index++) {
+                snapshot.capture(*section);
+                captures++;
+            }
+        }
+    });
+
+    Result result;
+    double totalMs = 0;
+    int checksum = 0;
+    auto start = Clock::now();
+    while (Clock::now() - start < RUN_TIME) {
+        auto frameStart = Clock::now();
+        {
+            std::unique_lock<CountedSharedMutex> lock(worldLock,
+                                                      std::defer_lock);
+            if (isWorldLocked) {
+                lock.lock();
+            }
+
+            auto lockChunk = [&](Chunk &chunk) {
+                std::unique_lock<CountedSharedMutex> chunkLock(chunk.getMutex(),
+                                                               std::defer_lock);
+                if (!isWorldLocked) {
+                    chunkLock.lock();
+                }
+                return chunkLock;
+            };
+
+            for (Chunk *chunk : order) {
+                auto chunkLock = lockChunk(*chunk);
+                checksum += drawChunk(*chunk);
+            }
+
+            Chunk &edited = *order[result.frames % order.size()];
+            auto chunkLock = lockChunk(edited);
+            edited.setBlock(8, 20, 8,
+                            result.frames % 2 ? BlockId::Stone : BlockId::Air);
+        }
+
+        std::chrono::duration<double, std::milli> frame = Clock::now() - frameStart;
+        totalMs += frame.count();
+        result.worstFrameMs = std::max(result.worstFrameMs, frame.count());
+        result.frames++;
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    isRunning = false;
+    loader.join();
+
+    result.meanFrameMs = totalMs / result.frames;
+    result.capturesPerSecond = captures / elapsed.count();
+    result.locks = isWorldLocked ? worldLockStatistics.take()
+                                 : Chunk::takeLockStatistics();
+    if (checksum == 0) {
+        std::cout << "Nothing was drawn\n";
+    }
+    return result;
+}
+} // namespace
+
+int main()
+{
+    FlatChunkMap<Chunk> chunks;
+    makeChunks(chunks);
+
+    std::cout << GRID << " x " << GRID << " chunks, "
+              << std::chrono::duration_cast<std::chrono::seconds>(RUN_TIME).count()
+              << " s per run\n\n"
+              << std::setw(12) << "locking" << std::setw(8) << "frames"
+              << std::setw(10) << "mean ms" << std::setw(10) << "worst ms"
+              << std::setw(12) << "captures/s" << std::setw(12) << "locks"
+              << std::setw(10) << "waited" << std::setw(10) << "wait ms"
+              << '\n';
+
+    for (bool isWorldLocked : {true, false}) {
+        Result result = run(chunks, isWorldLocked);
+        auto &locks = result.locks;
+
+        std::cout << std::setw(12) << (isWorldLocked ? "world" : "per chunk")
+                  << std::setw(8) << result.frames << std::fixed
+                  << std::setprecision(3) << std::setw(10) << result.meanFrameMs
+                  << std::setw(10) << result.worstFrameMs << std::setprecision(0)
+                  << std::setw(12) << result.capturesPerSecond << std::setw(12)
+                  << locks.acquisitions << std::setw(10) << locks.contended
+                  << std::setprecision(1) << std::setw(10)
+                  << locks.waitSeconds * 1000 << '\n';
+    }
+}
@@ -0,0 +1,149 @@
+#include "../Source/World/Chunk/FlatChunkMap.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Compares the std::unordered_map<VectorXZ, Chunk> that ChunkManager used to
+ * keep its chunks in against FlatChunkMap, for a square of loaded chunks at
+ * several render distances.
+ *
+ * Lookups follow the old ChunkManager::getChunk pattern (find, then
+ * operator[]) for the unordered map, and a single find for the flat map.
+ * All times are nanoseconds per operation.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Roughly the size of a Chunk, so both maps move comparable amounts of memory
+struct Payload {
+    Payload() = default;
+    Payload(int x, int z)
+        : x(x)
+        , z(z)
+    {
+    }
+
+    int x = 0, z = 0;
+    std::array<int, 268> heights{};
+};
+
+// Same key and hash as VectorXZ, without pulling in SFML
+struct Key {
+    int x, z;
+
+    bool operator==(const Key &other) const noexcept
+    {
+        return x == other.x && z == other.z;
+    }
+};
+
+struct KeyHash {
+    std::size_t operator()(const Key &key) const noexcept
+    {
+        std::hash<int> hasher;
+        return std::hash<int>{}((hasher(key.x) ^ hasher(key.z)) >> 2);
+    }
+};
+
+using NodeMap = std::unordered_map<Key, Payload, KeyHash>;
+using FlatMap = FlatChunkMap<Payload>;
+
+template <typename F>
+double nanosecondsPer(int operations, F &&function)
+{
+    auto start = Clock::now();
+    function();
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / operations;
+}
+
+void runRenderDistance(int renderDistance)
+{
+    std::minstd_rand rand(renderDistance);
+
+    std::vector<Key> keys;
+    for (int x = -renderDistance; x <= renderDistance; x++)
+        for (int z = -renderDistance; z <= renderDistance; z++)
+            keys.push_back({x + 1000, z + 1000});
+    std::shuffle(keys.begin(), keys.end(), rand);
+
+    // World::getBlock style access: many lookups clustered around the player
+    constexpr int LOOKUPS = 2'000'000;
+    std::vector<Key> lookups(LOOKUPS);
+    for (auto &key : lookups)
+        key = keys[rand() % keys.size()];
+
+    int count = (int)keys.size();
+    volatile long long sink = 0;
+    NodeMap nodeMap;
+    FlatMap flatMap;
+
+    double nodeInsert = nanosecondsPer(count, [&] {
+        for (auto &key : keys)
+            nodeMap.emplace(key, Payload{key.x, key.z});
+    });
+    double flatInsert = nanosecondsPer(count, [&] {
+        for (auto &key : keys)
+            flatMap.tryEmplace(key.x, key.z, key.x, key.z);
+    });
+
+    double nodeLookup = nanosecondsPer(LOOKUPS, [&] {
+        long long sum = 0;
+        for (auto &key : lookups) {
+            if (nodeMap.find(key) == nodeMap.end())
+                nodeMap.emplace(key, Payload{key.x, key.z});
+            sum += nodeMap[key].x;
+        }
+        sink = sink + sum;
+    });
+    double flatLookup = nanosecondsPer(LOOKUPS, [&] {
+        long long sum = 0;
+        for (auto &key : lookups)
+            sum += flatMap.tryEmplace(key.x, key.z, key.x, key.z).first->x;
+        sink = sink + sum;
+    });
+
+    std::shuffle(keys.begin(), keys.end(), rand);
+    double nodeErase = nanosecondsPer(count, [&] {
+        for (auto &key : keys)
+            nodeMap.erase(key);
+    });
+    double flatErase = nanosecondsPer(count, [&] {
+        for (auto &key : keys)
+            flatMap.erase(key.x, key.z);
+    });
+
+    if (nodeMap.size() != 0 || flatMap.size() != 0) {
+        std::cerr << "maps not empty after erasing every key\n";
+    }
+
+    std::cout << std::setw(4) << renderDistance << std::setw(8) << count
+              << std::fixed << std::setprecision(1) << std::setw(12)
+              << nodeLookup << std::setw(12) << flatLookup << std::setw(12)
+              << nodeInsert << std::setw(12) << flatInsert << std::setw(12)
+              << nodeErase << std::setw(12) << flatErase << '\n';
+}
+} // namespace
+
+int main()
+{
+    std::cout << "ns per operation, unordered_map vs FlatChunkMap\n\n"
+              << std::setw(4) << "rd" << std::setw(8) << "chunks"
+              << std::setw(12) << "get node" << std::setw(12) << "get flat"
+              << std::setw(12) << "insert node" << std::setw(12)
+              << "insert flat" << std::setw(12) << "erase node"
+              << std::setw(12) << "erase flat" << '\n';
+
+    for (int renderDistance : {8, 16, 32}) {
+        runRenderDistance(renderDistance);
+    }
+}
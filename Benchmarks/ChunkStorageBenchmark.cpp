@@ -0,0 +1,160 @@
+#include "../Source/World/Chunk/PalettedBlockStorage.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+/**
+ * Compares the flat one-byte-per-block section array that ChunkSection used
+ * to store against PalettedBlockStorage, for a few typical section contents.
+ *
+ * For every scenario it reports get and set throughput (million blocks per
+ * second) and the number of bytes a single section occupies.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using FlatStorage = std::array<Block_t, CHUNK_VOLUME>;
+
+constexpr int ITERATIONS = 200;
+
+struct Scenario {
+    std::string name;
+    std::function<Block_t(int x, int y, int z, std::minstd_rand &rand)> block;
+};
+
+int getIndex(int x, int y, int z)
+{
+    return y * CHUNK_AREA + z * CHUNK_SIZE + x;
+}
+
+template <typename F>
+double millionOpsPerSecond(F &&function)
+{
+    auto start = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        function();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return (double)ITERATIONS * CHUNK_VOLUME / elapsed.count() / 1'000'000.0;
+}
+
+void runScenario(const Scenario &scenario)
+{
+    std::minstd_rand rand(1234);
+    std::array<Block_t, CHUNK_VOLUME> blocks;
+    for (int y = 0; y < CHUNK_SIZE; y++)
+        for (int z = 0; z < CHUNK_SIZE; z++)
+            for (int x = 0; x < CHUNK_SIZE; x++)
+                blocks[getIndex(x, y, z)] = scenario.block(x, y, z, rand);
+
+    // Writes happen in a shuffled order so neither storage gets to rely on
+    // the order in which the terrain generator happens to fill sections
+    std::array<int, CHUNK_VOLUME> order;
+    for (int i = 0; i < CHUNK_VOLUME; i++)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), rand);
+
+    FlatStorage flat{};
+    PalettedBlockStorage paletted;
+    volatile unsigned sink = 0;
+
+    double flatSet = millionOpsPerSecond([&] {
+        flat.fill(0);
+        for (int i : order)
+            flat[i] = blocks[i];
+    });
+    double palettedSet = millionOpsPerSecond([&] {
+        paletted = PalettedBlockStorage();
+        for (int i : order)
+            paletted.set(i, blocks[i]);
+    });
+
+    double flatGet = millionOpsPerSecond([&] {
+        unsigned sum = 0;
+        for (int i = 0; i < CHUNK_VOLUME; i++)
+            sum += flat[i];
+        sink = sink + sum;
+    });
+    double palettedGet = millionOpsPerSecond([&] {
+        unsigned sum = 0;
+        for (int i = 0; i < CHUNK_VOLUME; i++)
+            sum += paletted.get(i);
+        sink = sink + sum;
+    });
+
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        if (paletted.get(i) != flat[i]) {
+            std::cerr << scenario.name << ": storage mismatch at " << i
+                      << '\n';
+        }
+    }
+
+    std::cout << std::left << std::setw(14) << scenario.name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << flatGet << std::setw(10) << palettedGet << std::setw(10)
+              << flatSet << std::setw(10) << palettedSet << std::setw(10)
+              << sizeof(FlatStorage) << std::setw(10)
+              << paletted.getMemoryUsage() << std::setw(6)
+              << paletted.getBitsPerIndex() << '\n';
+}
+} // namespace
+
+int main()
+{
+    auto id = [](BlockId block) { return static_cast<Block_t>(block); };
+
+    std::array<Scenario, 5> scenarios{{
+        {"air", [&](int, int, int, std::minstd_rand &) { return id(BlockId::Air); }},
+        {"stone", [&](int, int, int, std::minstd_rand &) { return id(BlockId::Stone); }},
+        {"surface",
+         [&](int, int y, int, std::minstd_rand &) {
+             if (y < 6)
+                 return id(BlockId::Stone);
+             if (y < 9)
+                 return id(BlockId::Dirt);
+             if (y == 9)
+                 return id(BlockId::Grass);
+             return id(BlockId::Air);
+         }},
+        {"forest",
+         [&](int, int y, int, std::minstd_rand &rand) {
+             if (y < 4)
+                 return id(BlockId::Dirt);
+             if (y == 4)
+                 return id(BlockId::Grass);
+             switch (rand() % 16) {
+                 case 0:
+                     return id(BlockId::OakBark);
+                 case 1:
+                 case 2:
+                     return id(BlockId::OakLeaf);
+                 case 3:
+                     return id(BlockId::TallGrass);
+                 default:
+                     return id(BlockId::Air);
+             }
+         }},
+        {"noise",
+         [&](int, int, int, std::minstd_rand &rand) {
+             return static_cast<Block_t>(rand() % (int)BlockId::NUM_TYPES);
+         }},
+    }};
+
+    std::cout << "Mblocks/s and bytes per section (" << ITERATIONS
+              << " passes of " << CHUNK_VOLUME << " blocks)\n\n"
+              << std::left << std::setw(14) << "scenario" << std::right
+              << std::setw(10) << "get flat" << std::setw(10) << "get pal"
+              << std::setw(10) << "set flat" << std::setw(10) << "set pal"
+              << std::setw(10) << "B flat" << std::setw(10) << "B pal"
+              << std::setw(6) << "bits" << '\n';
+
+    for (auto &scenario : scenarios) {
+        runScenario(scenario);
+    }
+}
@@ -0,0 +1,229 @@
+#include "../Source/World/Chunk/SectionColumns.h"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Compares the two ways ChunkMeshBuilder can find the visible faces of a
+ * section: checking the six neighbours of every block (the per face mesher),
+ * and SectionColumns (the column mesher).
+ *
+ * Every scenario fills a section plus a one block border around it. Only the
+ * face finding is timed, not building the vertices, and both paths must agree
+ * on the number of faces. Throughput is in sections per second.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int PADDED = CHUNK_SIZE + 2;
+constexpr int ITERATIONS = 2000;
+
+enum Block : uint8_t { Air, Stone, Dirt, Grass, Water, Glass };
+constexpr bool isOpaque[] = {false, true, true, true, false, false};
+
+using Volume = std::array<Block, PADDED * PADDED * PADDED>;
+
+struct Scenario {
+    std::string name;
+    std::function<Block(int x, int y, int z, std::minstd_rand &rand)> block;
+};
+
+// Coordinates run from -1 to CHUNK_SIZE, the border included
+int paddedIndex(int x, int y, int z)
+{
+    return ((y + 1) * PADDED + (z + 1)) * PADDED + (x + 1);
+}
+
+int sectionIndex(int x, int y, int z)
+{
+    return y * CHUNK_AREA + z * CHUNK_SIZE + x;
+}
+
+bool isFaceVisible(Block block, Block adjacent)
+{
+    return adjacent == Air || (!isOpaque[adjacent] && adjacent != block);
+}
+
+int countPerBlock(const Volume &volume)
+{
+    const int offsets[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                               {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+
+    int faces = 0;
+    for (int y = 0; y < CHUNK_SIZE; y++)
+        for (int z = 0; z < CHUNK_SIZE; z++)
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                Block block = volume[paddedIndex(x, y, z)];
+                if (block == Air)
+                    continue;
+
+                for (auto &o : offsets) {
+                    Block adjacent =
+                        volume[paddedIndex(x + o[0], y + o[1], z + o[2])];
+                    faces += isFaceVisible(block, adjacent);
+                }
+            }
+    return faces;
+}
+
+struct Masks {
+    SectionColumns::BlockMask opaque;
+    SectionColumns::BlockMask nonAir;
+    std::array<SectionColumns::FaceMask, 6> opaqueFaces;
+    std::array<SectionColumns::FaceMask, 6> nonAirFaces;
+};
+
+// The masks a ChunkSection and its neighbours keep up to date as blocks are
+// written, so building them is not part of the timing
+Masks buildMasks(const Volume &volume)
+{
+    Masks masks;
+    for (int y = 0; y < CHUNK_SIZE; y++)
+        for (int z = 0; z < CHUNK_SIZE; z++)
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                Block block = volume[paddedIndex(x, y, z)];
+                masks.opaque.set(sectionIndex(x, y, z), isOpaque[block]);
+                masks.nonAir.set(sectionIndex(x, y, z), block != Air);
+            }
+
+    for (int d = 0; d < 6; d++) {
+        for (int column = 0; column < CHUNK_AREA; column++) {
+            int x, y, z;
+            int border = (d & 1) ? CHUNK_SIZE : -1;
+            SectionColumns::getPosition(
+                static_cast<SectionColumns::Direction>(d), column, border, x,
+                y, z);
+
+            Block block = volume[paddedIndex(x, y, z)];
+            masks.opaqueFaces[d].set(column, isOpaque[block]);
+            masks.nonAirFaces[d].set(column, block != Air);
+        }
+    }
+    return masks;
+}
+
+int countColumns(const Volume &volume, const Masks &masks,
+                 SectionColumns &columns)
+{
+    SectionColumns::FaceMasks opaqueFaces;
+    SectionColumns::FaceMasks nonAirFaces;
+    for (int d = 0; d < 6; d++) {
+        opaqueFaces[d] = &masks.opaqueFaces[d];
+        nonAirFaces[d] = &masks.nonAirFaces[d];
+    }
+    columns.build(masks.opaque, masks.nonAir, opaqueFaces, nonAirFaces);
+
+    const int offsets[6][3] = {{-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                               {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+
+    int faces = 0;
+    for (int d = 0; d < 6; d++) {
+        auto direction = static_cast<SectionColumns::Direction>(d);
+        for (int column = 0; column < CHUNK_AREA; column++) {
+            auto columnFaces = columns.getFaces(direction, column);
+            faces += std::popcount(columnFaces.open);
+
+            // Only faces against another non-opaque block need the blocks
+            for (uint32_t bits = columnFaces.transparent; bits != 0;
+                 bits &= bits - 1) {
+                int x, y, z;
+                SectionColumns::getPosition(direction, column,
+                                            std::countr_zero(bits), x, y, z);
+                Block block = volume[paddedIndex(x, y, z)];
+                Block adjacent = volume[paddedIndex(
+                    x + offsets[d][0], y + offsets[d][1], z + offsets[d][2])];
+                faces += adjacent != block;
+            }
+        }
+    }
+    return faces;
+}
+
+template <typename F>
+double sectionsPerSecond(F &&function)
+{
+    auto start = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        function();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return ITERATIONS / elapsed.count();
+}
+
+void runScenario(const Scenario &scenario)
+{
+    std::minstd_rand rand(7);
+    Volume volume;
+    for (int y = -1; y <= CHUNK_SIZE; y++)
+        for (int z = -1; z <= CHUNK_SIZE; z++)
+            for (int x = -1; x <= CHUNK_SIZE; x++)
+                volume[paddedIndex(x, y, z)] = scenario.block(x, y, z, rand);
+
+    Masks masks = buildMasks(volume);
+    SectionColumns columns;
+
+    int perBlockFaces = countPerBlock(volume);
+    int columnFaces = countColumns(volume, masks, columns);
+    if (perBlockFaces != columnFaces) {
+        std::cerr << scenario.name << ": face counts differ, " << perBlockFaces
+                  << " vs " << columnFaces << '\n';
+    }
+
+    volatile int sink = 0;
+    double perBlock = sectionsPerSecond([&] { sink = countPerBlock(volume); });
+    double column = sectionsPerSecond(
+        [&] { sink = countColumns(volume, masks, columns); });
+
+    std::cout << std::left << std::setw(10) << scenario.name << std::right
+              << std::setw(8) << perBlockFaces << std::fixed
+              << std::setprecision(0) << std::setw(14) << perBlock
+              << std::setw(14) << column << std::setprecision(1)
+              << std::setw(8) << column / perBlock << "x\n";
+}
+} // namespace
+
+int main()
+{
+    std::vector<Scenario> scenarios = {
+        {"stone",
+         [](int, int, int, std::minstd_rand &) { return Stone; }},
+        {"surface",
+         [](int x, int y, int z, std::minstd_rand &) {
+             int height = 8 + (x + z) / 8;
+             return y < height - 3 ? Stone
+                    : y < height   ? Dirt
+                    : y == height  ? Grass
+                                   : Air;
+         }},
+        {"ocean",
+         [](int, int y, int, std::minstd_rand &) {
+             return y < 4 ? Stone : y < 14 ? Water : Air;
+         }},
+        {"caves",
+         [](int, int, int, std::minstd_rand &rand) {
+             return rand() % 4 == 0 ? Air : Stone;
+         }},
+        {"noise",
+         [](int, int, int, std::minstd_rand &rand) {
+             return static_cast<Block>(rand() % 6);
+         }},
+    };
+
+    std::cout << "sections per second, per block vs column masks\n\n"
+              << std::left << std::setw(10) << "section" << std::right
+              << std::setw(8) << "faces" << std::setw(14) << "per block"
+              << std::setw(14) << "columns" << std::setw(9) << "speedup"
+              << '\n';
+
+    for (auto &scenario : scenarios) {
+        runScenario(scenario);
+    }
+}
@@ -0,0 +1,119 @@
+#include "../Source/World/Chunk/Chunk.h"
+#include "../Source/World/Generation/GenerationPipeline.h"
+#include "../Source/World/Generation/Terrain/ClassicOverWorldGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures how many chunks per second the generation workers get through as
+ * the worker count grows.
+ *
+ * Every run generates the same square of chunks with a new
+ * ClassicOverWorldGenerator and GenerationPipeline, so each starts with
+ * empty terrain caches. The noise samples per chunk are shown next to the
+ * number a chunk took before the terrain cache shared layouts between
+ * neighbours.
+ *
+ * Every run checks that the chunks match the ones generated on one worker.
+ * Run from the repository root, so the structures in Res/ are found.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int CHUNKS_WIDE = 16;
+constexpr int SEED = 4242;
+
+using Chunks = std::vector<std::unique_ptr<Chunk>>;
+
+double chunksPerSecond(int workers, Chunks &chunks)
+{
+    ClassicOverWorldGenerator generator(SEED);
+
+    auto start = Clock::now();
+    {
+        GenerationPipeline pipeline(generator, workers);
+        for (int x = 0; x < CHUNKS_WIDE; x++)
+            for (int z = 0; z < CHUNKS_WIDE; z++) {
+                pipeline.request(x, z);
+            }
+
+        int finished = 0;
+        while (finished < (int)chunks.size()) {
+            for (auto &chunk : pipeline.takeFinished()) {
+                auto &location = chunk->getLocation();
+                chunks[location.x * CHUNKS_WIDE + location.y] = std::move(chunk);
+                finished++;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return chunks.size() / elapsed.count();
+}
+
+bool isSameTerrain(const Chunks &chunks, const Chunks &expected)
+{
+    for (int i = 0; i < (int)chunks.size(); i++) {
+        for (int y = 0; y < WORLD_HEIGHT; y++)
+            for (int z = 0; z < CHUNK_SIZE; z++)
+                for (int x = 0; x < CHUNK_SIZE; x++) {
+                    if (chunks[i]->getBlock(x, y, z) != expected[i]->getBlock(x, y, z)) {
+                        return false;
+                    }
+                }
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    const int chunkCount = CHUNKS_WIDE * CHUNKS_WIDE;
+    int hardwareThreads = (int)std::thread::hardware_concurrency();
+
+    // At least up to 4 workers, so the cost of oversubscribing shows on small
+    // machines
+    std::vector<int> workerCounts;
+    for (int workers = 1; workers < std::max(hardwareThreads, 4); workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(std::max(hardwareThreads, 4));
+
+    std::cout << chunkCount << " chunks, " << hardwareThreads
+              << " hardware threads, "
+              << ClassicOverWorldGenerator::UNCACHED_NOISE_SAMPLES
+              << " noise samples per chunk without the terrain cache\n\n"
+              << std::setw(8) << "workers" << std::setw(12) << "chunks/s"
+              << std::setw(10) << "speedup" << std::setw(14) << "noise/chunk"
+              << std::setw(10) << "matches" << '\n';
+
+    Chunks expected;
+    double single = 0;
+    for (int workers : workerCounts) {
+        ClassicOverWorldGenerator::takeStatistics();
+
+        Chunks chunks(chunkCount);
+        double rate = chunksPerSecond(workers, chunks);
+        auto terrain = ClassicOverWorldGenerator::takeStatistics();
+        if (workers == 1) {
+            single = rate;
+            expected = std::move(chunks);
+        }
+
+        bool matches = workers == 1 || isSameTerrain(chunks, expected);
+        std::cout << std::setw(8) << workers << std::fixed
+                  << std::setprecision(0) << std::setw(12) << rate
+                  << std::setprecision(2) << std::setw(9) << rate / single
+                  << 'x' << std::setw(14)
+                  << (terrain.chunks ? terrain.noiseSamples / terrain.chunks : 0)
+                  << std::setw(10) << (matches ? "yes" : "NO") << '\n';
+    }
+}
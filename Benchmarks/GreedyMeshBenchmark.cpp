@@ -0,0 +1,222 @@
+#include "../Source/World/Chunk/GreedyMeshing.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Compares one quad per exposed face against the greedy merge used by
+ * ChunkMeshBuilder::buildGreedyMesh, on a few generated terrain shapes.
+ *
+ * Each scenario fills a 4x4 area of chunks, 4 sections tall. Faces are found
+ * the way the mesher finds them (a face is exposed when its neighbour is air,
+ * or water next to a different block) and then either emitted one by one or
+ * merged per slice. Reported are vertices, buffer bytes and the time to turn
+ * the exposed faces into quads.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Same layout as ChunkMesh: two packed 32 bit words per vertex, six 32 bit
+// indices per quad
+constexpr int BYTES_PER_FACE = 4 * 2 * 4 + 6 * 4;
+constexpr int ITERATIONS = 20;
+
+constexpr int AREA_CHUNKS = 4;
+constexpr int HEIGHT = 4 * CHUNK_SIZE;
+constexpr int WIDTH = AREA_CHUNKS * CHUNK_SIZE;
+
+enum Block : uint16_t { Air, Grass, Dirt, Stone, Water, Sand };
+
+struct Scenario {
+    std::string name;
+    std::function<Block(int x, int y, int z, std::minstd_rand &rand)> block;
+};
+
+struct Quad {
+    float values[4 * 8];
+};
+
+struct Result {
+    long long faces = 0;
+    double milliseconds = 0;
+};
+
+Block terrainColumn(int y, int height)
+{
+    if (y > height)
+        return y <= 24 ? Water : Air;
+    if (y == height)
+        return height <= 25 ? Sand : Grass;
+    if (y > height - 4)
+        return Dirt;
+    return Stone;
+}
+
+bool isExposed(Block block, Block adjacent)
+{
+    return adjacent == Air || (adjacent == Water && block != Water);
+}
+
+class Terrain {
+  public:
+    Terrain(const Scenario &scenario)
+        : m_blocks(WIDTH * HEIGHT * WIDTH)
+    {
+        std::minstd_rand rand(42);
+        for (int x = 0; x < WIDTH; x++)
+            for (int z = 0; z < WIDTH; z++)
+                for (int y = 0; y < HEIGHT; y++)
+                    m_blocks[index(x, y, z)] = scenario.block(x, y, z, rand);
+    }
+
+    Block get(int x, int y, int z) const
+    {
+        if (x < 0 || y < 0 || z < 0 || x >= WIDTH || y >= HEIGHT ||
+            z >= WIDTH)
+            return Air;
+        return m_blocks[index(x, y, z)];
+    }
+
+  private:
+    static int index(int x, int y, int z)
+    {
+        return (y * WIDTH + z) * WIDTH + x;
+    }
+
+    std::vector<Block> m_blocks;
+};
+
+// Fills the face slices of one section and hands each to the callback
+template <typename F>
+void forEachSlice(const Terrain &terrain, int sx, int sy, int sz, F &&onSlice)
+{
+    // Normal axis, its direction, and the two axes spanning the slice
+    const int faces[6][4] = {{1, 1, 0, 2}, {1, -1, 0, 2}, {0, -1, 1, 2},
+                             {0, 1, 1, 2}, {2, 1, 0, 1},  {2, -1, 0, 1}};
+
+    FaceSlice slice;
+    for (auto &face : faces) {
+        for (int d = 0; d < CHUNK_SIZE; d++) {
+            for (int v = 0; v < CHUNK_SIZE; v++) {
+                for (int u = 0; u < CHUNK_SIZE; u++) {
+                    int p[3];
+                    p[face[0]] = d;
+                    p[face[2]] = u;
+                    p[face[3]] = v;
+                    p[0] += sx;
+                    p[1] += sy;
+                    p[2] += sz;
+
+                    Block block = terrain.get(p[0], p[1], p[2]);
+                    p[face[0]] += face[1];
+
+                    slice[v * CHUNK_SIZE + u] =
+                        block != Air &&
+                                isExposed(block, terrain.get(p[0], p[1], p[2]))
+                            ? block
+                            : 0;
+                }
+            }
+            onSlice(slice);
+        }
+    }
+}
+
+Result mesh(const Terrain &terrain, bool greedy)
+{
+    Result result;
+    std::vector<Quad> quads;
+
+    auto start = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        result.faces = 0;
+        for (int sy = 0; sy < HEIGHT; sy += CHUNK_SIZE)
+            for (int sz = 0; sz < WIDTH; sz += CHUNK_SIZE)
+                for (int sx = 0; sx < WIDTH; sx += CHUNK_SIZE) {
+                    quads.clear();
+                    forEachSlice(terrain, sx, sy, sz, [&](FaceSlice &slice) {
+                        if (greedy) {
+                            mergeFaces(slice, [&](uint16_t key, int u, int v,
+                                                  int w, int h) {
+                                quads.push_back({{(float)key, (float)u,
+                                                  (float)v, (float)w,
+                                                  (float)h}});
+                            });
+                        }
+                        else {
+                            for (int c = 0; c < CHUNK_AREA; c++)
+                                if (slice[c])
+                                    quads.push_back({{(float)slice[c]}});
+                        }
+                    });
+                    result.faces += quads.size();
+                }
+    }
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    result.milliseconds = elapsed.count() / ITERATIONS;
+    return result;
+}
+
+void runScenario(const Scenario &scenario)
+{
+    Terrain terrain(scenario);
+    Result perFace = mesh(terrain, false);
+    Result greedy = mesh(terrain, true);
+
+    std::cout << std::left << std::setw(10) << scenario.name << std::right
+              << std::setw(12) << perFace.faces * 4 << std::setw(12)
+              << greedy.faces * 4 << std::setw(12)
+              << perFace.faces * BYTES_PER_FACE / 1024 << std::setw(12)
+              << greedy.faces * BYTES_PER_FACE / 1024 << std::fixed
+              << std::setprecision(2) << std::setw(12) << perFace.milliseconds
+              << std::setw(12) << greedy.milliseconds << '\n';
+}
+} // namespace
+
+int main()
+{
+    std::vector<Scenario> scenarios = {
+        {"flat",
+         [](int, int y, int, std::minstd_rand &) {
+             return terrainColumn(y, 30);
+         }},
+        {"hills",
+         [](int x, int y, int z, std::minstd_rand &) {
+             int height = 30 + (int)(6 * std::sin(x * 0.15) +
+                                     6 * std::cos(z * 0.11));
+             return terrainColumn(y, height);
+         }},
+        {"rough",
+         [](int x, int y, int z, std::minstd_rand &rand) {
+             int height = 30 + (int)(10 * std::sin(x * 0.4) *
+                                     std::cos(z * 0.35)) +
+                          (int)(rand() % 2);
+             return terrainColumn(y, height);
+         }},
+        {"caves",
+         [](int, int y, int, std::minstd_rand &rand) {
+             Block block = terrainColumn(y, 40);
+             return block == Stone && rand() % 5 == 0 ? Air : block;
+         }},
+    };
+
+    std::cout << "4x4 chunks, 4 sections tall; vertices, buffer KiB and ms per "
+                 "pass, per face vs greedy\n\n"
+              << std::left << std::setw(10) << "terrain" << std::right
+              << std::setw(12) << "vtx face" << std::setw(12) << "vtx greedy"
+              << std::setw(12) << "KiB face" << std::setw(12) << "KiB greedy"
+              << std::setw(12) << "ms face" << std::setw(12) << "ms greedy"
+              << '\n';
+
+    for (auto &scenario : scenarios) {
+        runScenario(scenario);
+    }
+}
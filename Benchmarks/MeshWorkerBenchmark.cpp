@@ -0,0 +1,157 @@
+#include "../Source/Physics/AABB.h"
+#include "../Source/Util/MpscQueue.h"
+#include "../Source/Util/ThreadPool.h"
+#include "../Source/World/Chunk/Chunk.h"
+#include "../Source/World/Chunk/ChunkJobScheduler.h"
+#include "../Source/World/Chunk/ChunkMesh.h"
+#include "../Source/World/Chunk/ChunkMeshBuilder.h"
+#include "../Source/World/Chunk/ChunkSection.h"
+#include "../Source/World/Chunk/SectionSnapshot.h"
+#include "../Source/World/Generation/GenerationPipeline.h"
+#include "../Source/World/Generation/Terrain/ClassicOverWorldGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Measures how many sections per second the mesh workers get through as
+ * the worker count grows.
+ *
+ * A square of chunks is generated by the GenerationPipeline and linked to
+ * its neighbours. The sections of every chunk but the outer ring are
+ * captured into snapshots, then meshed the way World::queueMesh does it: a
+ * ChunkJobScheduler job per section runs the ChunkMeshBuilder on the
+ * snapshot and hands the meshes back through an MpscQueue.
+ *
+ * Run from the repository root, so the block data in Res/ is found.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int CHUNKS_WIDE = 18;
+constexpr int SEED = 4242;
+
+struct Job {
+    AABB bounds;
+    std::shared_ptr<const SectionSnapshot> snapshot;
+};
+
+std::vector<std::unique_ptr<Chunk>> generateChunks()
+{
+    ClassicOverWorldGenerator generator(SEED);
+    GenerationPipeline pipeline(generator, ThreadPool::getDefaultThreadCount());
+    for (int x = 0; x < CHUNKS_WIDE; x++)
+        for (int z = 0; z < CHUNKS_WIDE; z++) {
+            pipeline.request(x, z);
+        }
+
+    std::vector<std::unique_ptr<Chunk>> chunks(CHUNKS_WIDE * CHUNKS_WIDE);
+    int finished = 0;
+    while (finished < (int)chunks.size()) {
+        for (auto &chunk : pipeline.takeFinished()) {
+            auto &location = chunk->getLocation();
+            chunks[location.x * CHUNKS_WIDE + location.y] = std::move(chunk);
+            finished++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (int x = 0; x < CHUNKS_WIDE; x++)
+        for (int z = 0; z < CHUNKS_WIDE; z++) {
+            Chunk &chunk = *chunks[x * CHUNKS_WIDE + z];
+            if (x + 1 < CHUNKS_WIDE) {
+                chunk.linkNeighbour(1, 0, *chunks[(x + 1) * CHUNKS_WIDE + z]);
+            }
+            if (z + 1 < CHUNKS_WIDE) {
+                chunk.linkNeighbour(0, 1, *chunks[x * CHUNKS_WIDE + z + 1]);
+            }
+        }
+    return chunks;
+}
+
+std::vector<Job> captureSections(const std::vector<std::unique_ptr<Chunk>> &chunks)
+{
+    std::vector<Job> jobs;
+    for (int x = 1; x < CHUNKS_WIDE - 1; x++)
+        for (int z = 1; z < CHUNKS_WIDE - 1; z++) {
+            const Chunk &chunk = *chunks[x * CHUNKS_WIDE + z];
+            for (int y = 0; y < CHUNK_SECTIONS; y++) {
+                if (const ChunkSection *section = chunk.findSection(y)) {
+                    auto snapshot = std::make_shared<SectionSnapshot>();
+                    snapshot->capture(*section);
+                    jobs.push_back({section->getBounds(), std::move(snapshot)});
+                }
+            }
+        }
+    return jobs;
+}
+
+double sectionsPerSecond(int workers, const std::vector<Job> &jobs)
+{
+    MpscQueue<ChunkMeshCollection> built;
+
+    auto start = Clock::now();
+    {
+        ChunkJobScheduler scheduler(workers);
+        for (auto &job : jobs) {
+            auto snapshot = job.snapshot;
+            scheduler.push(job.bounds, [&built, snapshot] {
+                ChunkMeshCollection meshes;
+                ChunkMeshBuilder(*snapshot, meshes).buildMesh();
+                built.push(std::move(meshes));
+            });
+        }
+        // Sleeps rather than spins, so a worker gets this core on small machines
+        while (scheduler.getPendingCount() > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<ChunkMeshCollection> meshes;
+    built.takeAll(meshes);
+    return meshes.size() / elapsed.count();
+}
+} // namespace
+
+int main()
+{
+    auto chunks = generateChunks();
+    auto jobs = captureSections(chunks);
+    int hardwareThreads = (int)std::thread::hardware_concurrency();
+
+    // At least up to 4 workers, so the cost of oversubscribing shows on small
+    // machines
+    std::vector<int> workerCounts;
+    for (int workers = 1; workers < std::max(hardwareThreads, 4); workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(std::max(hardwareThreads, 4));
+
+    std::cout << jobs.size() << " sections, " << hardwareThreads
+              << " hardware threads\n\n"
+              << std::setw(8) << "workers" << std::setw(16) << "sections/s"
+              << std::setw(10) << "speedup" << std::setw(12) << "faces"
+              << '\n';
+
+    ChunkMeshBuilder::takeStatistics();
+    double single = 0;
+    for (int workers : workerCounts) {
+        double rate = sectionsPerSecond(workers, jobs);
+        if (workers == 1) {
+            single = rate;
+        }
+
+        std::cout << std::setw(8) << workers << std::fixed
+                  << std::setprecision(0) << std::setw(16) << rate
+                  << std::setprecision(2) << std::setw(9) << rate / single
+                  << 'x' << std::setw(12)
+                  << ChunkMeshBuilder::takeStatistics().faces << '\n';
+    }
+}
@@ -0,0 +1,120 @@
+#include "../Source/Maths/NoiseGenerator.h"
+#include "../Source/World/WorldConstants.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * Measures how many noise samples per second NoiseGenerator gives, one
+ * getHeight call per sample against one getHeightGrid call per grid.
+ *
+ * The grids are laid out like the biome maps of ClassicOverWorldGenerator,
+ * one chunk plus a row and column wide, and like larger areas. Every grid
+ * is checked to be bit for bit the same as the samples taken one by one.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int GRIDS = 2000;
+
+#if defined(__AVX2__)
+const char *KERNEL = "AVX2";
+#elif defined(__SSE2__) || defined(_M_X64)
+const char *KERNEL = "SSE2";
+#else
+const char *KERNEL = "scalar";
+#endif
+
+NoiseParameters makeParameters(int octaves, int amplitude, int smoothness,
+                               int heightOffset, double roughness)
+{
+    NoiseParameters parameters;
+    parameters.octaves = octaves;
+    parameters.amplitude = amplitude;
+    parameters.smoothness = smoothness;
+    parameters.heightOffset = heightOffset;
+    parameters.roughness = roughness;
+    return parameters;
+}
+
+// The world position of a grid, spread out like chunks being generated
+void gridOrigin(int grid, int width, int &x, int &z)
+{
+    x = (grid % 50) * width + 160;
+    z = (grid / 50) * width + 160;
+}
+
+double samplesPerSecond(const NoiseGenerator &noise, int width, bool useGrid,
+                        std::vector<double> &heights)
+{
+    heights.assign((std::size_t)GRIDS * width * width, 0.0);
+
+    auto start = Clock::now();
+    for (int grid = 0; grid < GRIDS; grid++) {
+        int originX, originZ;
+        gridOrigin(grid, width, originX, originZ);
+        double *out = heights.data() + (std::size_t)grid * width * width;
+
+        if (useGrid) {
+            noise.getHeightGrid(originX, originZ, width, width, out);
+            continue;
+        }
+
+        // Chunk and block coordinates, as the generator passes them
+        for (int z = 0; z < width; z++)
+            for (int x = 0; x < width; x++) {
+                int worldX = originX + x;
+                int worldZ = originZ + z;
+                out[z * width + x] =
+                    noise.getHeight(worldX % CHUNK_SIZE, worldZ % CHUNK_SIZE,
+                                    worldX / CHUNK_SIZE, worldZ / CHUNK_SIZE);
+            }
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return heights.size() / elapsed.count();
+}
+} // namespace
+
+int main()
+{
+    struct Case {
+        const char *name;
+        NoiseParameters parameters;
+    };
+    const Case cases[] = {
+        {"biomes", makeParameters(5, 120, 1035, 0, 0.75)},
+        {"grassland", makeParameters(9, 85, 235, -20, 0.51)},
+    };
+
+    std::cout << GRIDS << " grids per run, " << KERNEL << " kernel\n\n"
+              << std::setw(10) << "noise" << std::setw(7) << "grid"
+              << std::setw(16) << "getHeight/s" << std::setw(16) << "grid/s"
+              << std::setw(10) << "speedup" << std::setw(10) << "matches"
+              << '\n';
+
+    for (auto &test : cases) {
+        NoiseGenerator noise(4242);
+        noise.setParameters(test.parameters);
+
+        for (int width : {CHUNK_SIZE + 1, 64}) {
+            std::vector<double> expected;
+            std::vector<double> heights;
+            double single = samplesPerSecond(noise, width, false, expected);
+            double grid = samplesPerSecond(noise, width, true, heights);
+            bool matches = std::memcmp(expected.data(), heights.data(),
+                                       heights.size() * sizeof(double)) == 0;
+
+            std::cout << std::setw(10) << test.name << std::setw(7) << width
+                      << std::fixed << std::setprecision(0) << std::setw(16)
+                      << single << std::setw(16) << grid
+                      << std::setprecision(2) << std::setw(9) << grid / single
+                      << 'x' << std::setw(10) << (matches ? "yes" : "NO")
+                      << '\n';
+        }
+    }
+}
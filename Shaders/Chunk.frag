@@ -2,15 +2,22 @@
 
 out vec4 outColour;
 in  vec2 passTextureCoord;
+in  vec2 passTextureTile;
 in float passCardinalLight;
 
 uniform sampler2D texSampler;
+uniform float textureTileSize;
 
 vec4 color;
 
 void main()
 {
-    color = texture(texSampler, passTextureCoord);
+    // Texture coordinates count tiles, so faces spanning several blocks
+    // repeat their tile. The gradients come from the unwrapped coordinate to
+    // keep the mipmap level steady across tile seams.
+    vec2 tileCoord = passTextureTile + fract(passTextureCoord) * textureTileSize;
+    vec2 unwrapped = passTextureCoord * textureTileSize;
+    color = textureGrad(texSampler, tileCoord, dFdx(unwrapped), dFdy(unwrapped));
 
     outColour = color * passCardinalLight;
     if (outColour.a == 0) discard;
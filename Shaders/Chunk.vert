@@ -1,18 +1,32 @@
 #version 330
 
-layout(location = 0) in vec3  inVertexPosition;
-layout(location = 1) in vec2  inTextureCoord;
-layout(location = 2) in float inCardinalLight;
+// Packed by ChunkMesh::addFace: x, y and z inside the section, then u and v
+// in tiles, 5 bits each; tile column, tile row and light, 8 bits each
+layout(location = 0) in uvec2 inVertex;
 
 out vec2 passTextureCoord;
+out vec2 passTextureTile;
 out float passCardinalLight;
 
 uniform mat4 projViewMatrix;
+uniform vec3 chunkPosition;
+uniform float textureTileSize;
+uniform float textureTileStride;
+
+vec3 getVertexPosition()
+{
+    uvec3 position = uvec3(inVertex.x, inVertex.x >> 5u, inVertex.x >> 10u) & 31u;
+    return chunkPosition + vec3(position);
+}
 
 void main()
 {
-    gl_Position = projViewMatrix * vec4(inVertexPosition, 1.0);
+    gl_Position = projViewMatrix * vec4(getVertexPosition(), 1.0);
+
+    uvec2 tile = uvec2(inVertex.y, inVertex.y >> 8u) & 255u;
+    float inset = (textureTileStride - textureTileSize) * 0.5;
 
-    passTextureCoord    = inTextureCoord;
-    passCardinalLight   = inCardinalLight;
+    passTextureCoord    = vec2(uvec2(inVertex.x >> 15u, inVertex.x >> 20u) & 31u);
+    passTextureTile     = vec2(tile) * textureTileStride + inset;
+    passCardinalLight   = float((inVertex.y >> 16u) & 255u) / 255.0;
 }
@@ -1,19 +1,28 @@
 #version 330
 
-layout(location = 0) in vec3  inVertexPosition;
-layout(location = 1) in vec2  inTextureCoord;
-layout(location = 2) in float inCardinalLight;
+// Packed by ChunkMesh::addFace: x, y and z inside the section, then u and v
+// in tiles, 5 bits each; tile column, tile row and light, 8 bits each
+layout(location = 0) in uvec2 inVertex;
 
 out vec2 passTextureCoord;
+out vec2 passTextureTile;
 out float passCardinalLight;
 
 uniform mat4 projViewMatrix;
+uniform vec3 chunkPosition;
+uniform float textureTileSize;
+uniform float textureTileStride;
 uniform float globalTime;
 
+vec3 getVertexPosition()
+{
+    uvec3 position = uvec3(inVertex.x, inVertex.x >> 5u, inVertex.x >> 10u) & 31u;
+    return chunkPosition + vec3(position);
+}
 
 vec4 getWorldPos()
 {
-    vec3 inVert = inVertexPosition.xyz;
+    vec3 inVert = getVertexPosition();
     inVert.x += sin((globalTime + inVert.z + inVert.y) * 1.8f) / 15.0f;
     inVert.z -= cos((globalTime + inVert.x + inVert.y) * 1.8f) / 15.0f;
     return vec4(inVert, 1);
@@ -23,6 +32,10 @@ void main()
 {
     gl_Position = projViewMatrix * getWorldPos();
 
-    passTextureCoord    = inTextureCoord;
-    passCardinalLight   = inCardinalLight;
+    uvec2 tile = uvec2(inVertex.y, inVertex.y >> 8u) & 255u;
+    float inset = (textureTileStride - textureTileSize) * 0.5;
+
+    passTextureCoord    = vec2(uvec2(inVertex.x >> 15u, inVertex.x >> 20u) & 31u);
+    passTextureTile     = vec2(tile) * textureTileStride + inset;
+    passCardinalLight   = float((inVertex.y >> 16u) & 255u) / 255.0;
 }
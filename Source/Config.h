@@ -11,6 +11,15 @@
  * - Fullscreen mode (true/false)
  * - Render distance (how far the game world is rendered)
  * - Field of view (FOV) for the camera
+ * - Whether loaded chunks are kept in a ring buffer around the player instead
+ *   of a hash map
+ * - Whether chunk meshes merge neighbouring faces into larger quads, or find
+ *   their faces with column bit masks
+ * - The number of threads generating chunks and building chunk meshes
+ * - How much mesh data may be copied to the GPU each frame, and how many
+ *   buffers of unloaded chunks may be freed
+ * - How far past the render distance chunks stay loaded, and how much
+ *   memory unloaded chunks are cached in
  * 
  * @note
  * The default values are set to reasonable defaults for a typical gaming experience.
@@ -22,6 +31,24 @@ struct Config {
     bool isFullscreen = false;
     int renderDistance = 8; // Set initial RD low to prevent long load times
     int fov = 90;
+    bool ringChunkStorage = false;
+    bool greedyMeshing = false;
+    bool columnMeshing = false;
+    // For both, 0 leaves one hardware thread free and uses the rest
+    int generationWorkers = 0;
+    int meshWorkers = 0;
+    // Finished chunk meshes uploaded per frame, stopping once either limit is
+    // passed; at least one is always uploaded, and 0 lifts a limit
+    int meshUploadKiBPerFrame = 1024;
+    float meshUploadMsPerFrame = 2.0f;
+    // Buffers of unloaded chunks freed per frame; 0 frees them all at once
+    int meshDeletesPerFrame = 256;
+    // Chunks load one chunk beyond the render distance, for the neighbours
+    // of the edge, and unload this many chunks beyond the render distance,
+    // at least that one, so walking along the edge does not reload them
+    int unloadMargin = 2;
+    // Unloaded chunks kept compressed to load again; 0 disables the cache
+    int coldCacheMiB = 64;
 };
 
 #endif // CONFIG_H_INCLUDED
@@ -137,6 +137,56 @@ void loadConfig(Config &config)
                     configFile >> config.fov;
                     std::cout << "Config: Field of Vision: " << config.fov << '\n';
                 }
+                else if (key == "ringchunkstorage") {
+                    configFile >> config.ringChunkStorage;
+                    std::cout << "Config: Ring chunk storage: " << std::boolalpha
+                            << config.ringChunkStorage << '\n';
+                }
+                else if (key == "greedymeshing") {
+                    configFile >> config.greedyMeshing;
+                    std::cout << "Config: Greedy meshing: " << std::boolalpha
+                            << config.greedyMeshing << '\n';
+                }
+                else if (key == "columnmeshing") {
+                    configFile >> config.columnMeshing;
+                    std::cout << "Config: Column meshing: " << std::boolalpha
+                            << config.columnMeshing << '\n';
+                }
+                else if (key == "generationworkers") {
+                    configFile >> config.generationWorkers;
+                    std::cout << "Config: Generation workers: "
+                            << config.generationWorkers << '\n';
+                }
+                else if (key == "meshworkers") {
+                    configFile >> config.meshWorkers;
+                    std::cout << "Config: Mesh workers: " << config.meshWorkers
+                            << '\n';
+                }
+                else if (key == "meshuploadkib") {
+                    configFile >> config.meshUploadKiBPerFrame;
+                    std::cout << "Config: Mesh upload KiB per frame: "
+                            << config.meshUploadKiBPerFrame << '\n';
+                }
+                else if (key == "meshuploadms") {
+                    configFile >> config.meshUploadMsPerFrame;
+                    std::cout << "Config: Mesh upload ms per frame: "
+                            << config.meshUploadMsPerFrame << '\n';
+                }
+                else if (key == "meshdeletes") {
+                    configFile >> config.meshDeletesPerFrame;
+                    std::cout << "Config: Mesh deletes per frame: "
+                            << config.meshDeletesPerFrame << '\n';
+                }
+                else if (key == "unloadmargin") {
+                    configFile >> config.unloadMargin;
+                    std::cout << "Config: Unload margin: " << config.unloadMargin
+                            << '\n';
+                }
+                else if (key == "coldcachemib") {
+                    configFile >> config.coldCacheMiB;
+                    std::cout << "Config: Cold chunk cache MiB: "
+                            << config.coldCacheMiB << '\n';
+                }
             }
         }
     }
@@ -2,7 +2,109 @@
 
 #include "../World/WorldConstants.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+
+// The grid kernels must round exactly like getHeight, which they would not if
+// the compiler fused some multiplies and adds into FMA instructions
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(__AVX2__)
+#define NOISE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define NOISE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+// getNoise for the lattice point n, in unsigned arithmetic so overflow wraps
+// the way it does in practice for getNoise
+double latticeNoise(int n, int seed) noexcept
+{
+    uint32_t u = (uint32_t)n + (uint32_t)seed;
+    u = (u << 13) ^ u;
+    u = (u * (u * u * 60493u + 19990303u) + 1376312589u) & 0x7fffffffu;
+
+    return 1.0 - ((double)u / 1073741824.0);
+}
+
+double blend(double a, double b, double weight) noexcept
+{
+    return (a * (1 - weight) + b * weight);
+}
+
+#if defined(NOISE_AVX2)
+// latticeNoise for eight lattice points at once
+__m256i hashLattice(__m256i n, __m256i seed) noexcept
+{
+    n = _mm256_add_epi32(n, seed);
+    n = _mm256_xor_si256(_mm256_slli_epi32(n, 13), n);
+
+    __m256i inner = _mm256_mullo_epi32(_mm256_mullo_epi32(n, n),
+                                       _mm256_set1_epi32(60493));
+    inner = _mm256_add_epi32(inner, _mm256_set1_epi32(19990303));
+
+    __m256i hash = _mm256_add_epi32(_mm256_mullo_epi32(n, inner),
+                                    _mm256_set1_epi32(1376312589));
+    return _mm256_and_si256(hash, _mm256_set1_epi32(0x7fffffff));
+}
+
+__m256d toNoise(__m128i hash) noexcept
+{
+    return _mm256_sub_pd(
+        _mm256_set1_pd(1.0),
+        _mm256_div_pd(_mm256_cvtepi32_pd(hash), _mm256_set1_pd(1073741824.0)));
+}
+
+__m256d blend(__m256d a, __m256d b, __m256d weight) noexcept
+{
+    return _mm256_add_pd(_mm256_mul_pd(a, _mm256_sub_pd(_mm256_set1_pd(1.0), weight)),
+                         _mm256_mul_pd(b, weight));
+}
+#elif defined(NOISE_SSE2)
+// SSE2 has no 32 bit multiply keeping the low halves, so it is made of two
+// 64 bit ones
+__m128i multiply(__m128i a, __m128i b) noexcept
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// latticeNoise for four lattice points at once
+__m128i hashLattice(__m128i n, __m128i seed) noexcept
+{
+    n = _mm_add_epi32(n, seed);
+    n = _mm_xor_si128(_mm_slli_epi32(n, 13), n);
+
+    __m128i inner = multiply(multiply(n, n), _mm_set1_epi32(60493));
+    inner = _mm_add_epi32(inner, _mm_set1_epi32(19990303));
+
+    __m128i hash = _mm_add_epi32(multiply(n, inner), _mm_set1_epi32(1376312589));
+    return _mm_and_si128(hash, _mm_set1_epi32(0x7fffffff));
+}
+
+// Converts the low two hashes
+__m128d toNoise(__m128i hash) noexcept
+{
+    return _mm_sub_pd(_mm_set1_pd(1.0),
+                      _mm_div_pd(_mm_cvtepi32_pd(hash), _mm_set1_pd(1073741824.0)));
+}
+
+__m128d blend(__m128d a, __m128d b, __m128d weight) noexcept
+{
+    return _mm_add_pd(_mm_mul_pd(a, _mm_sub_pd(_mm_set1_pd(1.0), weight)),
+                      _mm_mul_pd(b, weight));
+}
+#endif
+} // namespace
 
 NoiseGenerator::NoiseGenerator(int seed)
     : m_seed(seed)
@@ -12,11 +114,23 @@ NoiseGenerator::NoiseGenerator(int seed)
     m_noiseParameters.smoothness = 235;
     m_noiseParameters.heightOffset = -5;
     m_noiseParameters.roughness = 0.53;
+    makeOctaveTables();
 }
 
 void NoiseGenerator::setParameters(const NoiseParameters &params) noexcept
 {
     m_noiseParameters = params;
+    makeOctaveTables();
+}
+
+void NoiseGenerator::makeOctaveTables()
+{
+    m_octaveFrequencies.clear();
+    m_octaveAmplitudes.clear();
+    for (int a = 0; a < m_noiseParameters.octaves - 1; a++) {
+        m_octaveFrequencies.push_back(std::pow(2.0, a));
+        m_octaveAmplitudes.push_back(std::pow(m_noiseParameters.roughness, a));
+    }
 }
 
 double NoiseGenerator::getNoise(int n) const noexcept
@@ -77,11 +191,11 @@ double NoiseGenerator::getHeight(int x, int z, int chunkX, int chunkZ) const
 
     auto totalValue = 0.0;
 
-    for (auto a = 0; a < m_noiseParameters.octaves - 1;
+    for (auto a = 0; a < (int)m_octaveFrequencies.size();
          a++) // This loops through the octaves.
     {
-        auto frequency = pow(2.0, a); // This increases the frequency with every loop of the octave.
-        auto amplitude = pow(m_noiseParameters.roughness, a); // This decreases the amplitude with every loop of the octave.
+        auto frequency = m_octaveFrequencies[a]; // This increases the frequency with every loop of the octave.
+        auto amplitude = m_octaveAmplitudes[a]; // This decreases the amplitude with every loop of the octave.
         totalValue +=
             noise(((double)world_x) * frequency / m_noiseParameters.smoothness,
                   ((double)world_z) * frequency / m_noiseParameters.smoothness) *
@@ -93,3 +207,121 @@ double NoiseGenerator::getHeight(int x, int z, int chunkX, int chunkZ) const
 
     return val > 0 ? val : 1; // Compare if value is greater than 0
 }
+
+void NoiseGenerator::getHeightGrid(int originX, int originZ, int width, int depth,
+                                   double *heights) const
+{
+    std::fill(heights, heights + width * depth, 0.0);
+
+    std::vector<int> cellsX(width);
+    std::vector<int> cellsZ(depth);
+    std::vector<double> weightsX(width);
+    std::vector<double> weightsZ(depth);
+
+    // Works out the cells and weights as noise does, for one axis
+    auto makeAxis = [&](int origin, int count, double frequency, int *cells,
+                        double *weights) {
+        for (int i = 0; i < count; i++) {
+            double value =
+                ((double)(origin + i)) * frequency / m_noiseParameters.smoothness;
+            double floor = (double)((int)value);
+
+            cells[i] = (int)floor;
+            weights[i] = (1 - std::cos((value - floor) * 3.14)) / 2;
+        }
+    };
+
+    for (int a = 0; a < (int)m_octaveFrequencies.size(); a++) {
+        makeAxis(originX, width, m_octaveFrequencies[a], cellsX.data(),
+                 weightsX.data());
+        makeAxis(originZ, depth, m_octaveFrequencies[a], cellsZ.data(),
+                 weightsZ.data());
+
+        for (int z = 0; z < depth; z++) {
+            addOctaveRow(cellsX.data(), weightsX.data(), cellsZ[z] * 57,
+                         weightsZ[z], m_octaveAmplitudes[a],
+                         heights + z * width, width);
+        }
+    }
+
+    for (int z = 0; z < depth; z++)
+        for (int x = 0; x < width; x++) {
+            double &height = heights[z * width + x];
+            if (originX + x < 0 || originZ + z < 0) {
+                height = WATER_LEVEL - 1;
+                continue;
+            }
+
+            auto val = (((height / 2.1) + 1.2) * m_noiseParameters.amplitude) +
+                       m_noiseParameters.heightOffset;
+            height = val > 0 ? val : 1;
+        }
+}
+
+void NoiseGenerator::addOctaveRow(const int *cellsX, const double *weightsX,
+                                  int rowCell, double weightZ, double amplitude,
+                                  double *row, int width) const noexcept
+{
+    int x = 0;
+
+#if defined(NOISE_AVX2)
+    const __m256i seed = _mm256_set1_epi32(m_seed);
+    const __m256d rowWeight = _mm256_set1_pd(weightZ);
+    const __m256d octaveAmplitude = _mm256_set1_pd(amplitude);
+
+    for (; x + 4 <= width; x += 4) {
+        __m128i cells = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(cellsX + x)),
+                                      _mm_set1_epi32(rowCell));
+
+        // The corners of four cells: s and t in one vector, u and v in the other
+        __m256i near = _mm256_set_m128i(_mm_add_epi32(cells, _mm_set1_epi32(1)), cells);
+        __m256i nearHash = hashLattice(near, seed);
+        __m256i farHash =
+            hashLattice(_mm256_add_epi32(near, _mm256_set1_epi32(57)), seed);
+
+        __m256d weight = _mm256_loadu_pd(weightsX + x);
+        __m256d rec1 = blend(toNoise(_mm256_castsi256_si128(nearHash)),
+                             toNoise(_mm256_extracti128_si256(nearHash, 1)), weight);
+        __m256d rec2 = blend(toNoise(_mm256_castsi256_si128(farHash)),
+                             toNoise(_mm256_extracti128_si256(farHash, 1)), weight);
+        __m256d rec3 = blend(rec1, rec2, rowWeight);
+
+        _mm256_storeu_pd(row + x, _mm256_add_pd(_mm256_loadu_pd(row + x),
+                                                _mm256_mul_pd(rec3, octaveAmplitude)));
+    }
+#elif defined(NOISE_SSE2)
+    const __m128i seed = _mm_set1_epi32(m_seed);
+    const __m128d rowWeight = _mm_set1_pd(weightZ);
+    const __m128d octaveAmplitude = _mm_set1_pd(amplitude);
+
+    for (; x + 2 <= width; x += 2) {
+        __m128i cells = _mm_add_epi32(_mm_loadl_epi64((const __m128i *)(cellsX + x)),
+                                      _mm_set1_epi32(rowCell));
+
+        // The corners of two cells: s, s, t, t in one vector, u, u, v, v in
+        // the other
+        __m128i near = _mm_unpacklo_epi64(cells, _mm_add_epi32(cells, _mm_set1_epi32(1)));
+        __m128i nearHash = hashLattice(near, seed);
+        __m128i farHash = hashLattice(_mm_add_epi32(near, _mm_set1_epi32(57)), seed);
+
+        __m128d weight = _mm_loadu_pd(weightsX + x);
+        __m128d rec1 = blend(toNoise(nearHash),
+                             toNoise(_mm_unpackhi_epi64(nearHash, nearHash)), weight);
+        __m128d rec2 = blend(toNoise(farHash),
+                             toNoise(_mm_unpackhi_epi64(farHash, farHash)), weight);
+        __m128d rec3 = blend(rec1, rec2, rowWeight);
+
+        _mm_storeu_pd(row + x,
+                      _mm_add_pd(_mm_loadu_pd(row + x), _mm_mul_pd(rec3, octaveAmplitude)));
+    }
+#endif
+
+    for (; x < width; x++) {
+        int n = cellsX[x] + rowCell;
+        double rec1 = blend(latticeNoise(n, m_seed), latticeNoise(n + 1, m_seed),
+                            weightsX[x]);
+        double rec2 = blend(latticeNoise(n + 57, m_seed),
+                            latticeNoise(n + 58, m_seed), weightsX[x]);
+        row[x] += blend(rec1, rec2, weightZ) * amplitude;
+    }
+}
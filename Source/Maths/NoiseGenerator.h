@@ -1,6 +1,8 @@
 #ifndef NOISEGENERATOR_H_INCLUDED
 #define NOISEGENERATOR_H_INCLUDED
 
+#include <vector>
+
 /**
  * 
  */
@@ -56,6 +58,27 @@ class NoiseGenerator {
      */
     double getHeight(int x, int z, int chunkX, int chunkZ) const noexcept;
 
+    /**
+     * @brief Gets the heights of a grid of blocks in one go.
+     *
+     * @param originX The world x coordinate of the first block.
+     * @param originZ The world z coordinate of the first block.
+     * @param width The number of blocks along x.
+     * @param depth The number of blocks along z.
+     * @param heights Receives width * depth heights, the height of the block
+     *                at (originX + x, originZ + z) at index z * width + x.
+     *
+     * @details
+     * Gives exactly the heights getHeight would, with world coordinates
+     * x + chunkX * CHUNK_SIZE and z + chunkZ * CHUNK_SIZE. The lattice cells
+     * and cosine weights only depend on one axis each, so they are worked
+     * out once per row and column instead of for every sample, and the
+     * samples of a row are hashed and blended with SSE2 or AVX2 where the
+     * build enables them.
+     */
+    void getHeightGrid(int originX, int originZ, int width, int depth,
+                       double *heights) const;
+
     /**
      * @brief Sets the parameters for the noise generation.
      * 
@@ -129,8 +152,29 @@ class NoiseGenerator {
      */
     double noise(double x, double z) const noexcept;
 
+    /**
+     * @brief Adds one octave of noise to a row of a height grid.
+     *
+     * @param cellsX The lattice cell of each column.
+     * @param weightsX The cosine weight of each column within its cell.
+     * @param rowCell The lattice cell of the row, times 57.
+     * @param weightZ The cosine weight of the row within its cell.
+     * @param amplitude The amplitude of the octave.
+     * @param row The totals of the row.
+     * @param width The number of columns.
+     */
+    void addOctaveRow(const int *cellsX, const double *weightsX, int rowCell,
+                      double weightZ, double amplitude, double *row,
+                      int width) const noexcept;
+
+    /// @brief Works out the frequency and amplitude of every octave.
+    void makeOctaveTables();
+
     NoiseParameters m_noiseParameters;
 
+    std::vector<double> m_octaveFrequencies;
+    std::vector<double> m_octaveAmplitudes;
+
     int m_seed;
 };
 
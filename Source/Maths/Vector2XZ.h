@@ -1,7 +1,7 @@
 #ifndef VECTOR2XZ_H_INCLUDED
 #define VECTOR2XZ_H_INCLUDED
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector3.hpp>
 #include <functional>
 
 /**
@@ -77,6 +77,22 @@ void Model::addVBO(int dimensions, const std::vector<GLfloat> &data)
     m_buffers.push_back(vbo);
 }
 
+void Model::addVBO(int dimensions, const std::vector<GLuint> &data)
+{
+    GLuint vbo;
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(GLuint), data.data(),
+                 GL_STATIC_DRAW);
+
+    glVertexAttribIPointer(static_cast<GLuint>(m_vboCount), dimensions,
+                           GL_UNSIGNED_INT, 0, (GLvoid *)0);
+
+    glEnableVertexAttribArray(static_cast<GLuint>(m_vboCount++));
+
+    m_buffers.push_back(vbo);
+}
+
 void Model::addEBO(const std::vector<GLuint> &indices)
 {
     m_renderInfo.indicesCount = static_cast<GLuint>(indices.size());
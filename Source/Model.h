@@ -24,6 +24,8 @@ class Model : public NonCopyable {
     void genVAO();
     void addEBO(const std::vector<GLuint> &indices);
     void addVBO(int dimensions, const std::vector<GLfloat> &data);
+    /// @brief Adds a buffer of unsigned integers, read as uint/uvec in the shader.
+    void addVBO(int dimensions, const std::vector<GLuint> &data);
     void bindVAO() const;
 
     int getIndicesCount() const;
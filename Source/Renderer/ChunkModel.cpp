@@ -0,0 +1,37 @@
+#include "ChunkModel.h"
+
+#include "../World/Chunk/ChunkMesh.h"
+
+ChunkModel::ChunkModel(const ChunkMesh &mesh)
+    : m_worldPosition(mesh.getWorldPosition())
+{
+    if (mesh.faces == 0) {
+        return;
+    }
+
+    m_model.genVAO();
+    m_model.addVBO(2, mesh.getVertices());
+    m_model.addEBO(mesh.getIndices());
+}
+
+const Model &ChunkModel::getModel() const
+{
+    return m_model;
+}
+
+const sf::Vector3f &ChunkModel::getWorldPosition() const
+{
+    return m_worldPosition;
+}
+
+bool ChunkModel::isEmpty() const
+{
+    return m_model.getIndicesCount() == 0;
+}
+
+ChunkModels::ChunkModels(const ChunkMeshCollection &meshes)
+    : solidModel(meshes.solidMesh)
+    , waterModel(meshes.waterMesh)
+    , floraModel(meshes.floraMesh)
+{
+}
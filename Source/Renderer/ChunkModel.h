@@ -0,0 +1,50 @@
+#ifndef CHUNKMODEL_H_INCLUDED
+#define CHUNKMODEL_H_INCLUDED
+
+#include <SFML/System/Vector3.hpp>
+
+#include "../Model.h"
+#include "../World/Chunk/IChunkRenderer.h"
+
+class ChunkMesh;
+
+/**
+ * @class ChunkModel
+ * @brief One chunk mesh copied into GPU buffers.
+ *
+ * @details
+ * Empty meshes are not buffered at all, so they cost no GL objects.
+ */
+class ChunkModel {
+  public:
+    explicit ChunkModel(const ChunkMesh &mesh);
+
+    const Model &getModel() const;
+
+    /// @brief Gets the world position of the section, which vertices are relative to.
+    const sf::Vector3f &getWorldPosition() const;
+
+    bool isEmpty() const;
+
+  private:
+    Model m_model;
+    sf::Vector3f m_worldPosition;
+};
+
+/**
+ * @struct ChunkModels
+ * @brief The GPU copies of the meshes of one section.
+ *
+ * @details
+ * Handed to the section as its IChunkMeshHandle by RenderMaster::bufferMesh,
+ * and cast back when RenderMaster draws it.
+ */
+struct ChunkModels : public IChunkMeshHandle {
+    explicit ChunkModels(const ChunkMeshCollection &meshes);
+
+    ChunkModel solidModel;
+    ChunkModel waterModel;
+    ChunkModel floraModel;
+};
+
+#endif // CHUNKMODEL_H_INCLUDED
@@ -1,18 +1,18 @@
 #include "ChunkRenderer.h"
 
-#include "../World/Block/BlockDatabase.h"
-#include "../World/Chunk/ChunkMesh.h"
+#include "../Texture/TextureAtlas.h"
+#include "ChunkModel.h"
 
 #include "../Camera.h"
 
 #include <iostream>
 
-void ChunkRenderer::add(const ChunkMesh &mesh)
+void ChunkRenderer::add(const ChunkModel &mesh)
 {
-    m_chunks.push_back(&mesh.getModel().getRenderInfo());
+    m_chunks.push_back(&mesh);
 }
 
-void ChunkRenderer::render(const Camera &camera)
+void ChunkRenderer::render(const Camera &camera, const TextureAtlas &atlas)
 {
     if (m_chunks.empty()) {
         return;
@@ -22,13 +22,19 @@ void ChunkRenderer::render(const Camera &camera)
     glEnable(GL_CULL_FACE);
 
     m_shader.useProgram();
-    BlockDatabase::get().textureAtlas.bindTexture();
+    atlas.bindTexture();
 
     m_shader.loadProjectionViewMatrix(camera.getProjectionViewMatrix());
+    m_shader.loadTextureTileSize(atlas.getTileSize());
+    m_shader.loadTextureTileStride(atlas.getTileStride());
 
     for (auto mesh : m_chunks) {
-        GL::bindVAO(mesh->vao);
-        GL::drawElements(mesh->indicesCount);
+        auto position = mesh->getWorldPosition();
+        m_shader.loadChunkPosition({position.x, position.y, position.z});
+
+        auto &renderInfo = mesh->getModel().getRenderInfo();
+        GL::bindVAO(renderInfo.vao);
+        GL::drawElements(renderInfo.indicesCount);
     }
 
     m_chunks.clear();
@@ -5,9 +5,9 @@
 
 #include "../Shaders/ChunkShader.h"
 
-struct RenderInfo;
-class ChunkMesh;
 class Camera;
+class ChunkModel;
+class TextureAtlas;
 
 ///@todo potentially createa base class for all renderers to inherit from
 
@@ -31,16 +31,17 @@ class ChunkRenderer {
      * @details
      * This method adds a chunk mesh to the renderer's list of chunks to be
      * rendered. The mesh is passed by reference, and the method stores a pointer
-     * to the render information of the mesh. This allows the renderer to
+     * to the mesh itself. This allows the renderer to
      * efficiently render the mesh later without needing to copy the entire
      * mesh data.
      */
-    void add(const ChunkMesh &mesh);
+    void add(const ChunkModel &mesh);
 
     /**
      * @brief Renders the chunk meshes using the provided camera.
      * 
      * @param camera The camera used for rendering.
+     * @param atlas The texture atlas of the blocks.
      * 
      * @details
      * This method renders the chunk meshes using the provided camera's view
@@ -49,15 +50,16 @@ class ChunkRenderer {
      * and enables face culling to optimize rendering. The shader program is
      * activated, and the texture atlas is bound for rendering. The projection
      * and view matrices are loaded into the shader program. Finally, the method
-     * iterates through the list of chunk meshes, binds the Vertex Array Object
-     * (VAO) for each mesh, and draws the elements using the indices count.
+     * iterates through the list of chunk meshes, loads the position of each mesh's
+     * section, binds its Vertex Array Object (VAO), and draws the elements
+     * using the indices count.
      * After rendering, the list of chunks is cleared to prepare for the next
      * rendering cycle.
      */
-    void render(const Camera &camera);
+    void render(const Camera &camera, const TextureAtlas &atlas);
 
   private:
-    std::vector<const RenderInfo *> m_chunks;
+    std::vector<const ChunkModel *> m_chunks;
 
     ChunkShader m_shader;
 };
@@ -2,17 +2,17 @@
 
 #include "../Application.h"
 #include "../Camera.h"
-#include "../World/Block/BlockDatabase.h"
-#include "../World/Chunk/ChunkMesh.h"
+#include "../Texture/TextureAtlas.h"
+#include "ChunkModel.h"
 
 #include <iostream>
 
-void FloraRenderer::add(const ChunkMesh &mesh)
+void FloraRenderer::add(const ChunkModel &mesh)
 {
-    m_chunks.push_back(&mesh.getModel().getRenderInfo());
+    m_chunks.push_back(&mesh);
 }
 
-void FloraRenderer::render(const Camera &camera)
+void FloraRenderer::render(const Camera &camera, const TextureAtlas &atlas)
 {
     if (m_chunks.empty()) {
         return;
@@ -23,11 +23,17 @@ void FloraRenderer::render(const Camera &camera)
     m_shader.useProgram();
 
     m_shader.loadProjectionViewMatrix(camera.getProjectionViewMatrix());
+    m_shader.loadTextureTileSize(atlas.getTileSize());
+    m_shader.loadTextureTileStride(atlas.getTileStride());
     m_shader.loadTime(g_timeElapsed);
 
     for (auto mesh : m_chunks) {
-        GL::bindVAO(mesh->vao);
-        GL::drawElements(mesh->indicesCount);
+        auto position = mesh->getWorldPosition();
+        m_shader.loadChunkPosition({position.x, position.y, position.z});
+
+        auto &renderInfo = mesh->getModel().getRenderInfo();
+        GL::bindVAO(renderInfo.vao);
+        GL::drawElements(renderInfo.indicesCount);
     }
 
     m_chunks.clear();
@@ -6,9 +6,9 @@
 
 #include "../Shaders/FloraShader.h"
 
-struct RenderInfo;
-class ChunkMesh;
 class Camera;
+class ChunkModel;
+class TextureAtlas;
 
 /**
  * @class FloraRenderer
@@ -30,16 +30,17 @@ class FloraRenderer {
      * @details
      * This method adds a chunk mesh to the renderer's list of flora chunks to be
      * rendered. The mesh is passed by reference, and the method stores a pointer
-     * to the render information of the mesh. This allows the renderer to
+     * to the mesh itself. This allows the renderer to
      * efficiently render the mesh later without needing to copy the entire
      * mesh data.
      */
-    void add(const ChunkMesh &mesh);
+    void add(const ChunkModel &mesh);
     
     /**
      * @brief Renders the flora chunks using the provided camera.
      * 
      * @param camera The camera used for rendering.
+     * @param atlas The texture atlas of the blocks.
      * 
      * @details
      * This method renders the flora chunks using the provided camera's view
@@ -48,15 +49,16 @@ class FloraRenderer {
      * and enables face culling to optimize rendering. The shader program is
      * activated, and the texture atlas is bound for rendering. The projection
      * and view matrices are loaded into the shader program. Finally, the method
-     * iterates through the list of flora chunks, binds the Vertex Array Object
-     * (VAO) for each chunk, and draws the elements using the indices count.
+     * iterates through the list of flora chunks, loads the position of each chunk's
+     * section, binds its Vertex Array Object (VAO), and draws the elements
+     * using the indices count.
      * After rendering, the list of chunks is cleared to prepare for the next
      * rendering cycle.
      */
-    void render(const Camera &camera);
+    void render(const Camera &camera, const TextureAtlas &atlas);
 
   private:
-    std::vector<const RenderInfo *> m_chunks;
+    std::vector<const ChunkModel *> m_chunks;
 
     FloraShader m_shader;
 };
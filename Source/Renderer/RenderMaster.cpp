@@ -5,36 +5,45 @@
 
 #include "../Application.h"
 #include "../Context.h"
-#include "../World/Chunk/ChunkMesh.h"
-#include "../World/Chunk/ChunkSection.h"
+#include "ChunkModel.h"
 
 /**
  * @brief Renders the world using OpenGL.
  */
 
+// The block textures come from the first pack, not the second.
+RenderMaster::RenderMaster()
+    : m_blockAtlas("DefaultPack")
+{
+}
+
+std::unique_ptr<IChunkMeshHandle>
+RenderMaster::bufferMesh(const ChunkMeshCollection &meshes)
+{
+    return std::make_unique<ChunkModels>(meshes);
+}
+
 /**
  * @brief Draws a chunk section.
  * 
- * @param chunk The chunk section to draw.
+ * @param meshes The section's meshes, as buffered by bufferMesh.
  * 
  * @details
- * This method adds the chunk's solid, water, and flora meshes to their respective
- * renderers. It checks if each mesh has faces before adding it to the renderer.
+ * This method adds the chunk's solid, water, and flora models to their respective
+ * renderers. It checks if each model has faces before adding it to the renderer.
  */
-void RenderMaster::drawChunk(const ChunkSection &chunk)
+void RenderMaster::drawChunk(const IChunkMeshHandle &meshes)
 {
-    const auto &solidMesh = chunk.getMeshes().solidMesh;
-    const auto &waterMesh = chunk.getMeshes().waterMesh;
-    const auto &floraMesh = chunk.getMeshes().floraMesh;
+    const auto &models = static_cast<const ChunkModels &>(meshes);
 
-    if (solidMesh.faces > 0)
-        m_chunkRenderer.add(solidMesh);
+    if (!models.solidModel.isEmpty())
+        m_chunkRenderer.add(models.solidModel);
 
-    if (waterMesh.faces > 0)
-        m_waterRenderer.add(waterMesh);
+    if (!models.waterModel.isEmpty())
+        m_waterRenderer.add(models.waterModel);
 
-    if (floraMesh.faces > 0)
-        m_floraRenderer.add(floraMesh);
+    if (!models.floraModel.isEmpty())
+        m_floraRenderer.add(models.floraModel);
 }
 
 /**
@@ -66,9 +75,9 @@ void RenderMaster::finishRender(sf::RenderWindow &window, const Camera &camera)
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
-    m_chunkRenderer.render(camera);
-    m_waterRenderer.render(camera);
-    m_floraRenderer.render(camera);
+    m_chunkRenderer.render(camera, m_blockAtlas);
+    m_waterRenderer.render(camera, m_blockAtlas);
+    m_floraRenderer.render(camera, m_blockAtlas);
 
     if (m_drawBox) {
         glDisable(GL_CULL_FACE);
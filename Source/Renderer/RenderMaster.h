@@ -4,23 +4,33 @@
 #include <SFML/Graphics.hpp>
 
 #include "../Config.h"
+#include "../Texture/TextureAtlas.h"
+#include "../World/Chunk/IChunkRenderer.h"
 #include "ChunkRenderer.h"
 #include "FloraRenderer.h"
 #include "SkyboxRenderer.h"
 #include "WaterRenderer.h"
 
 class Camera;
-class ChunkSection;
 
 /// @brief Master rendering class that handles the sum of drawn in-game objects.
-class RenderMaster {
+class RenderMaster : public IChunkRenderer {
   public:
-    void drawChunk(const ChunkSection &chunk);
+    RenderMaster();
+
+    /// @brief Buffers the meshes as ChunkModels.
+    std::unique_ptr<IChunkMeshHandle>
+    bufferMesh(const ChunkMeshCollection &meshes) override;
+
+    void drawChunk(const IChunkMeshHandle &meshes) override;
     void drawSky();
 
     void finishRender(sf::RenderWindow &window, const Camera &camera);
 
   private:
+    // The block textures, shared by the chunk renderers
+    TextureAtlas m_blockAtlas;
+
     // Chunks
     ChunkRenderer m_chunkRenderer;
     WaterRenderer m_waterRenderer;
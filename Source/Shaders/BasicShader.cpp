@@ -17,10 +17,29 @@ void BasicShader::loadModelMatrix(const glm::mat4 &matrix)
     loadMatrix4(m_locationModelMatrix, matrix);
 }
 
+void BasicShader::loadTextureTileSize(float size)
+{
+    loadFloat(m_locationTextureTileSize, size);
+}
+
+void BasicShader::loadTextureTileStride(float stride)
+{
+    loadFloat(m_locationTextureTileStride, stride);
+}
+
+void BasicShader::loadChunkPosition(const glm::vec3 &position)
+{
+    loadVector3(m_locationChunkPosition, position);
+}
+
 void BasicShader::getUniforms()
 {
     useProgram();
     m_locationProjectionViewMatrix =
         glGetUniformLocation(m_id, "projViewMatrix");
     m_locationModelMatrix = glGetUniformLocation(m_id, "modelMatrix");
+    m_locationTextureTileSize = glGetUniformLocation(m_id, "textureTileSize");
+    m_locationTextureTileStride =
+        glGetUniformLocation(m_id, "textureTileStride");
+    m_locationChunkPosition = glGetUniformLocation(m_id, "chunkPosition");
 }
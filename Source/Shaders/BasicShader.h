@@ -19,6 +19,9 @@ class BasicShader : public Shader {
 
     void loadProjectionViewMatrix(const glm::mat4 &pvMatrix);
     void loadModelMatrix(const glm::mat4 &matrix);
+    void loadTextureTileSize(float size);
+    void loadTextureTileStride(float stride);
+    void loadChunkPosition(const glm::vec3 &position);
 
   protected:
     virtual void getUniforms() override;
@@ -26,6 +29,9 @@ class BasicShader : public Shader {
   private:
     GLuint m_locationProjectionViewMatrix;
     GLuint m_locationModelMatrix;
+    GLuint m_locationTextureTileSize;
+    GLuint m_locationTextureTileStride;
+    GLuint m_locationChunkPosition;
 };
 
 #endif // BASICSHADER_H_INCLUDED
@@ -1,6 +1,7 @@
 #include "PlayState.h"
 
 #include "../Application.h"
+#include "../Input/ToggleKey.h"
 #include "../Maths/Ray.h"
 #include "../Renderer/RenderMaster.h"
 #include "../World/Event/PlayerDigEvent.h"
@@ -11,8 +12,11 @@
 
 StatePlay::StatePlay(Application &app, const Config &config)
     : StateBase(app)
-    , m_world(app.getCamera(), config, m_player)
+    , m_world(app.getCamera(), config)
 {
+    glm::vec3 spawnPoint = m_world.getPlayerSpawnPoint() + glm::vec3(0.f, 1.f, 0.f);
+    m_player.setSpawn(spawnPoint);
+    m_player.setPosition(spawnPoint);
     app.getCamera().hookEntity(m_player);
 
     m_debugText.setPosition(sf::Vector2f(10.f,35.f));
@@ -74,20 +78,41 @@ void StatePlay::handleInput()
 
 }
 
+/// @todo add keyboard to config file
 void StatePlay::update(float deltaTime)
 {
+    static ToggleKey meshKey(sf::Keyboard::C);
+    static ToggleKey statisticsKey(sf::Keyboard::M);
+
+    if (meshKey.isKeyPressed()) {
+        m_world.deleteMeshes();
+    }
+
+    if (statisticsKey.isKeyPressed()) {
+        m_world.printGenerationStatistics();
+        m_world.printMeshStatistics();
+        m_world.printLockStatistics();
+        m_world.printJobStatistics();
+        m_world.printUploadStatistics();
+        m_world.printColdCacheStatistics();
+        m_frameTimes.print(std::cout);
+        m_frameTimes.reset();
+    }
+
     if (m_player.position.x < 0)
         m_player.position.x = 0;
     if (m_player.position.z < 0)
         m_player.position.z = 0;
 
     m_fpsCounter.update();
+    m_frameTimes.record(deltaTime);
     m_player.update(deltaTime, m_world);
     m_world.update(m_pApplication->getCamera());
 }
 
 void StatePlay::render(RenderMaster &renderer)
 {
+    renderer.drawSky();
     m_world.renderWorld(renderer, m_pApplication->getCamera());
 }
 
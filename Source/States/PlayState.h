@@ -6,6 +6,7 @@
 
 #include "../Input/Keyboard.h"
 #include "../Util/FPSCounter.h"
+#include "../Util/FrameTimeHistogram.h"
 #include "../World/Chunk/Chunk.h"
 #include "../World/World.h"
 
@@ -87,6 +88,7 @@ class StatePlay : public StateBase {
     World m_world;
 
     FPSCounter m_fpsCounter;
+    FrameTimeHistogram m_frameTimes; // Since the statistics were last printed
 
     sf::Text m_debugText;
     sf::Font m_font;
@@ -13,18 +13,12 @@ TextureAtlas::TextureAtlas(const std::string &textureFileName)
     m_individualTextureSize = 16;
 }
 
-std::array<GLfloat, 8> TextureAtlas::getTexture(const sf::Vector2i &coords)
+GLfloat TextureAtlas::getTileStride() const
 {
-    static const GLfloat TEX_PER_ROW =
-        (GLfloat)m_imageSize / (GLfloat)m_individualTextureSize;
-    static const GLfloat INDV_TEX_SIZE = 1.0f / TEX_PER_ROW;
-    static const GLfloat PIXEL_SIZE = 1.0f / (float)m_imageSize;
-
-    GLfloat xMin = (coords.x * INDV_TEX_SIZE) + 0.5f * PIXEL_SIZE;
-    GLfloat yMin = (coords.y * INDV_TEX_SIZE) + 0.5f * PIXEL_SIZE;
-
-    GLfloat xMax = (xMin + INDV_TEX_SIZE) - PIXEL_SIZE;
-    GLfloat yMax = (yMin + INDV_TEX_SIZE) - PIXEL_SIZE;
+    return (GLfloat)m_individualTextureSize / (GLfloat)m_imageSize;
+}
 
-    return {xMax, yMax, xMin, yMax, xMin, yMin, xMax, yMin};
+GLfloat TextureAtlas::getTileSize() const
+{
+    return (GLfloat)(m_individualTextureSize - 1) / (GLfloat)m_imageSize;
 }
@@ -8,7 +8,20 @@ class TextureAtlas : public BasicTexture {
   public:
     TextureAtlas(const std::string &textureFileName);
 
-    std::array<GLfloat, 8> getTexture(const sf::Vector2i &coords);
+    /**
+     * @brief Gets the distance between the origins of neighbouring tiles.
+     *
+     * @details
+     * Chunk meshes store the column and row of a tile rather than atlas
+     * coordinates, and texture coordinates in tiles so the shader can repeat
+     * a tile across a merged face. The shader samples at
+     * tile * stride + inset + fract(coord) * getTileSize(), where the inset
+     * (stride - getTileSize()) / 2 moves to the first texel centre.
+     */
+    GLfloat getTileStride() const;
+
+    /// @brief Gets the distance between a tile's first and last texel centre.
+    GLfloat getTileSize() const;
 
   private:
     int m_imageSize;
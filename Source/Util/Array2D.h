@@ -69,6 +69,17 @@ template <typename T, int WIDTH> class Array2D {
         return *std::max_element(m_array.begin(), m_array.end());
     }
 
+    const T &getMaxValue() const
+    {
+        return *std::max_element(m_array.begin(), m_array.end());
+    }
+
+    /// @brief Gets the minimum value in the array.
+    const T &getMinValue() const
+    {
+        return *std::min_element(m_array.begin(), m_array.end());
+    }
+
     /**
      * @brief Sets all elements in the array to the specified value.
      * 
@@ -0,0 +1,120 @@
+#ifndef BITMASK_H_INCLUDED
+#define BITMASK_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * @class BitMask
+ * @brief A fixed size set of bits, stored as 64 bit words.
+ *
+ * @details
+ * Unlike std::bitset, the words are exposed so callers can test or scan 64
+ * bits at a time.
+ *
+ * @tparam BITS The number of bits in the mask, a multiple of 64.
+ */
+template <int BITS> class BitMask {
+    static_assert(BITS % 64 == 0, "BitMask size must be a multiple of 64");
+
+  public:
+    static constexpr int NUM_WORDS = BITS / 64;
+
+    bool test(int index) const noexcept
+    {
+        return (m_words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void set(int index, bool value) noexcept
+    {
+        uint64_t bit = uint64_t(1) << (index & 63);
+        if (value) {
+            m_words[index >> 6] |= bit;
+        }
+        else {
+            m_words[index >> 6] &= ~bit;
+        }
+    }
+
+    /// @brief Sets or clears the bits in the range [first, first + count).
+    void setRange(int first, int count, bool value) noexcept
+    {
+        int last = first + count;
+        while (first < last) {
+            int bits = std::min(64 - (first & 63), last - first);
+            uint64_t mask = bits == 64 ? ~uint64_t(0)
+                                       : ((uint64_t(1) << bits) - 1) << (first & 63);
+            if (value) {
+                m_words[first >> 6] |= mask;
+            }
+            else {
+                m_words[first >> 6] &= ~mask;
+            }
+            first += bits;
+        }
+    }
+
+    /**
+     * @brief Checks if every bit in the range [first, first + count) of words
+     * is set.
+     */
+    bool allWords(int first, int count) const noexcept
+    {
+        for (int i = first; i < first + count; i++) {
+            if (m_words[i] != ~uint64_t(0)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if any bit in the range [first, first + count) of words
+     * is set.
+     */
+    bool anyWords(int first, int count) const noexcept
+    {
+        for (int i = first; i < first + count; i++) {
+            if (m_words[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool all() const noexcept
+    {
+        return allWords(0, NUM_WORDS);
+    }
+
+    bool any() const noexcept
+    {
+        return anyWords(0, NUM_WORDS);
+    }
+
+    int count() const noexcept
+    {
+        int total = 0;
+        for (uint64_t word : m_words) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    void fill(bool value) noexcept
+    {
+        m_words.fill(value ? ~uint64_t(0) : 0);
+    }
+
+    uint64_t getWord(int index) const noexcept
+    {
+        return m_words[index];
+    }
+
+  private:
+    std::array<uint64_t, NUM_WORDS> m_words{};
+};
+
+#endif // BITMASK_H_INCLUDED
@@ -0,0 +1,59 @@
+#include "FrameTimeHistogram.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+void FrameTimeHistogram::record(float seconds) noexcept
+{
+    float milliseconds = seconds * 1000;
+
+    int bucket = 0;
+    while (bucket < (int)BUCKET_LIMITS_MS.size() &&
+           milliseconds > BUCKET_LIMITS_MS[bucket]) {
+        bucket++;
+    }
+    m_counts[bucket]++;
+
+    m_frames++;
+    m_totalMs += milliseconds;
+    m_worstMs = std::max(m_worstMs, milliseconds);
+}
+
+void FrameTimeHistogram::print(std::ostream &out) const
+{
+    if (m_frames == 0) {
+        out << "No frames since the last report\n";
+        return;
+    }
+
+    // Formatted apart, so the caller's stream keeps its own format
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1) << "Frame times: " << m_frames
+           << " frames, " << m_totalMs / m_frames << " ms mean, " << m_worstMs
+           << " ms worst\n";
+
+    float lower = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        report << std::setw(7) << lower << " - ";
+        if (i < (int)BUCKET_LIMITS_MS.size()) {
+            report << std::setw(5) << BUCKET_LIMITS_MS[i] << " ms";
+            lower = BUCKET_LIMITS_MS[i];
+        }
+        else {
+            report << "  ... ms";
+        }
+
+        // One # per percent of the frames
+        float share = m_counts[i] * 100.0f / m_frames;
+        report << std::setw(8) << m_counts[i] << std::setw(7) << share << "% "
+            << std::string((std::size_t)share, '#') << '\n';
+    }
+    out << report.str();
+}
+
+void FrameTimeHistogram::reset() noexcept
+{
+    *this = {};
+}
@@ -0,0 +1,38 @@
+#ifndef FRAMETIMEHISTOGRAM_H_INCLUDED
+#define FRAMETIMEHISTOGRAM_H_INCLUDED
+
+#include <array>
+#include <ostream>
+
+/**
+ * @class FrameTimeHistogram
+ * @brief Counts frames by how long they took, to show hitches an average
+ * frame rate hides.
+ *
+ * @details
+ * Frames are sorted into buckets by their upper bound in milliseconds: one
+ * and two refreshes at 60 Hz, then ever longer hitches. Frames longer than
+ * the last bound go into a final bucket of their own.
+ */
+class FrameTimeHistogram {
+  public:
+    static constexpr std::array<float, 5> BUCKET_LIMITS_MS = {8.3f, 16.7f, 33.3f,
+                                                              50.0f, 100.0f};
+    static constexpr int NUM_BUCKETS = BUCKET_LIMITS_MS.size() + 1;
+
+    void record(float seconds) noexcept;
+
+    /// @brief Prints the frames recorded since the last reset, one bucket per
+    /// line.
+    void print(std::ostream &out) const;
+
+    void reset() noexcept;
+
+  private:
+    std::array<int, NUM_BUCKETS> m_counts{};
+    int m_frames = 0;
+    float m_totalMs = 0;
+    float m_worstMs = 0;
+};
+
+#endif // FRAMETIMEHISTOGRAM_H_INCLUDED
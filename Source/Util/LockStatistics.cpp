@@ -0,0 +1,95 @@
+#include "LockStatistics.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Threads take shards in the order they first lock anything, so up to the
+// number of shards each thread has one to itself
+unsigned getThreadShard() noexcept
+{
+    static std::atomic<unsigned> nextShard{0};
+    thread_local unsigned shard = nextShard.fetch_add(1, std::memory_order_relaxed);
+    return shard;
+}
+} // namespace
+
+void LockStatistics::record(bool isContended, Clock::duration wait) noexcept
+{
+    m_shards[getThreadShard() % NUM_SHARDS].acquisitions.fetch_add(
+        1, std::memory_order_relaxed);
+    if (isContended) {
+        auto nanoseconds =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+        m_contended.fetch_add(1, std::memory_order_relaxed);
+        m_waitNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+LockStatistics::Totals LockStatistics::take() noexcept
+{
+    Totals totals;
+    for (auto &shard : m_shards) {
+        totals.acquisitions += shard.acquisitions.exchange(0, std::memory_order_relaxed);
+    }
+    totals.contended = m_contended.exchange(0, std::memory_order_relaxed);
+    totals.waitSeconds =
+        m_waitNanoseconds.exchange(0, std::memory_order_relaxed) / 1e9;
+    return totals;
+}
+
+CountedSharedMutex::CountedSharedMutex(LockStatistics &statistics) noexcept
+    : m_statistics(&statistics)
+{
+}
+
+void CountedSharedMutex::lock()
+{
+    if (m_mutex.try_lock()) {
+        m_statistics->record(false, {});
+        return;
+    }
+
+    auto start = Clock::now();
+    m_mutex.lock();
+    m_statistics->record(true, Clock::now() - start);
+}
+
+bool CountedSharedMutex::try_lock()
+{
+    bool isLocked = m_mutex.try_lock();
+    if (isLocked) {
+        m_statistics->record(false, {});
+    }
+    return isLocked;
+}
+
+void CountedSharedMutex::unlock()
+{
+    m_mutex.unlock();
+}
+
+void CountedSharedMutex::lock_shared()
+{
+    if (m_mutex.try_lock_shared()) {
+        m_statistics->record(false, {});
+        return;
+    }
+
+    auto start = Clock::now();
+    m_mutex.lock_shared();
+    m_statistics->record(true, Clock::now() - start);
+}
+
+bool CountedSharedMutex::try_lock_shared()
+{
+    bool isLocked = m_mutex.try_lock_shared();
+    if (isLocked) {
+        m_statistics->record(false, {});
+    }
+    return isLocked;
+}
+
+void CountedSharedMutex::unlock_shared()
+{
+    m_mutex.unlock_shared();
+}
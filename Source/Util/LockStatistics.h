@@ -0,0 +1,77 @@
+#ifndef LOCKSTATISTICS_H_INCLUDED
+#define LOCKSTATISTICS_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+
+#include "NonCopyable.h"
+
+/**
+ * @class LockStatistics
+ * @brief Counts how often a group of locks was taken, and how long threads
+ * waited to take them.
+ *
+ * @details
+ * Shared by every lock of a kind, such as all chunk locks, so the counts
+ * outlive the objects the locks belong to. Safe to update from any thread.
+ *
+ * Locks taken without waiting are counted in one of several shards, each on
+ * its own cache line and picked by the thread, so threads locking different
+ * chunks do not contend on the counts either. Only waits, rare by
+ * comparison, are added to counts every thread shares.
+ */
+class LockStatistics {
+  public:
+    struct Totals {
+        long long acquisitions = 0;
+        long long contended = 0; // Acquisitions that had to wait
+        double waitSeconds = 0;
+    };
+
+    void record(bool isContended,
+                std::chrono::steady_clock::duration wait) noexcept;
+
+    /// @brief Returns the totals gathered so far and resets them.
+    Totals take() noexcept;
+
+  private:
+    static constexpr int NUM_SHARDS = 16;
+
+    struct alignas(64) Shard {
+        std::atomic<long long> acquisitions{0};
+    };
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+    std::atomic<long long> m_contended{0};
+    std::atomic<long long> m_waitNanoseconds{0};
+};
+
+/**
+ * @class CountedSharedMutex
+ * @brief A std::shared_mutex that records every lock in a LockStatistics.
+ *
+ * @details
+ * Each lock is tried first, and only timed if that fails, so a lock nobody
+ * else holds costs one extra atomic add, on a counter of the thread's own.
+ * Works with std::unique_lock and std::shared_lock like the mutex it wraps.
+ */
+class CountedSharedMutex : public NonCopyable {
+  public:
+    explicit CountedSharedMutex(LockStatistics &statistics) noexcept;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+  private:
+    std::shared_mutex m_mutex;
+    LockStatistics *m_statistics;
+};
+
+#endif // LOCKSTATISTICS_H_INCLUDED
@@ -0,0 +1,83 @@
+#ifndef MPSCQUEUE_H_INCLUDED
+#define MPSCQUEUE_H_INCLUDED
+
+#include <atomic>
+#include <utility>
+
+#include "NonCopyable.h"
+
+/**
+ * @class MpscQueue
+ * @brief A lock-free queue any number of threads push to and a single thread
+ * takes from.
+ *
+ * @details
+ * Items are linked onto an atomic list with one compare-and-swap each, so
+ * a producer never waits on the consumer or on other producers. The consumer
+ * swaps the whole list out at once and reverses it, so items pushed by one
+ * thread come out in the order they were pushed. As nodes are only ever
+ * removed all together, the list cannot suffer from the ABA problem.
+ */
+template <typename T> class MpscQueue : public NonCopyable {
+  public:
+    MpscQueue() = default;
+
+    ~MpscQueue()
+    {
+        deleteNodes(m_head.exchange(nullptr));
+    }
+
+    void push(T value)
+    {
+        Node *node = new Node{std::move(value), m_head.load(std::memory_order_relaxed)};
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Moves every item pushed so far onto the back of the container,
+     * oldest first.
+     *
+     * @details
+     * Must only be called from one thread at a time.
+     */
+    template <typename Container> void takeAll(Container &items)
+    {
+        Node *newest = m_head.exchange(nullptr, std::memory_order_acquire);
+
+        Node *oldest = nullptr;
+        while (newest) {
+            Node *next = newest->next;
+            newest->next = oldest;
+            oldest = newest;
+            newest = next;
+        }
+
+        while (oldest) {
+            items.push_back(std::move(oldest->value));
+            Node *next = oldest->next;
+            delete oldest;
+            oldest = next;
+        }
+    }
+
+  private:
+    struct Node {
+        T value;
+        Node *next;
+    };
+
+    static void deleteNodes(Node *node)
+    {
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    std::atomic<Node *> m_head{nullptr};
+};
+
+#endif // MPSCQUEUE_H_INCLUDED
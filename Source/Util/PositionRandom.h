@@ -0,0 +1,98 @@
+#ifndef POSITIONRANDOM_H_INCLUDED
+#define POSITIONRANDOM_H_INCLUDED
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class PositionRandom
+ * @brief Stateless random numbers keyed by a seed, a block position and a
+ * purpose.
+ *
+ * @details
+ * Every draw is a hash of its key and a counter, so there is no engine state
+ * to share or reseed. The numbers drawn for a position do not depend on what
+ * was drawn before, or on which thread asked, which keeps generation the
+ * same whatever order chunks and blocks are generated in.
+ *
+ * Giving each decision its own purpose keeps them independent of each
+ * other: asking whether a plant grows never shifts which block the surface
+ * gets.
+ */
+class PositionRandom {
+  public:
+    /// @brief The decisions made with random numbers, one key each.
+    enum class Purpose : uint32_t {
+        Surface,   // The surface block and whether a plant grows on it
+        Plant,     // Which plant grows
+        Tree,      // Whether a tree grows, its kind and its variant
+        Structure, // Which other structure grows and its variant
+    };
+
+    /**
+     * @class Stream
+     * @brief The numbers drawn for one key, in order.
+     *
+     * @details
+     * Has the same intInRange as Random, so code drawing numbers works with
+     * either.
+     */
+    class Stream {
+      public:
+        explicit Stream(uint64_t key) noexcept
+            : m_key(key)
+        {
+        }
+
+        /**
+         * @brief Draws an integer in the range [low, high].
+         *
+         * @details
+         * The range is scaled with a multiply and shift rather than by
+         * rejection, so each draw costs a fixed few integer operations. Some
+         * values come up one draw in 2^32 more often than others, a bias of
+         * about range / 2^32: one in four million for a range of a
+         * thousand, far too small to show in the terrain.
+         */
+        template <typename T> T intInRange(T low, T high) noexcept
+        {
+            static_assert(std::is_integral<T>::value, "Not integral type!");
+            uint64_t range = (uint64_t)((int64_t)high - (int64_t)low) + 1;
+            uint64_t bits = mix(m_key + GOLDEN_GAMMA * ++m_counter) >> 32;
+
+            return (T)((int64_t)low + (int64_t)((bits * range) >> 32));
+        }
+
+      private:
+        uint64_t m_key;
+        uint64_t m_counter = 0;
+    };
+
+    explicit PositionRandom(uint32_t seed) noexcept
+        : m_seed(mix(seed))
+    {
+    }
+
+    /// @brief Gets the numbers for a decision at a block position.
+    Stream at(int x, int y, int z, Purpose purpose) const noexcept
+    {
+        uint64_t key = mix(m_seed ^ (uint32_t)x);
+        key = mix(key ^ ((uint64_t)(uint32_t)y << 32 | (uint32_t)z));
+        return Stream(mix(key ^ (uint64_t)purpose));
+    }
+
+  private:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15;
+
+    // The splitmix64 finaliser, which spreads every input bit over the output
+    static uint64_t mix(uint64_t value) noexcept
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t m_seed;
+};
+
+#endif // POSITIONRANDOM_H_INCLUDED
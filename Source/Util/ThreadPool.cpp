@@ -0,0 +1,84 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    for (int i = 0; i < std::max(threadCount, 1); i++) {
+        m_threads.emplace_back([this] { run(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+        m_pendingCount -= (int)m_jobs.size();
+        m_jobs.clear();
+    }
+    m_jobPushed.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::push(Job job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+        m_pendingCount++;
+    }
+    m_jobPushed.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobFinished.wait(lock, [this] { return m_pendingCount == 0; });
+}
+
+int ThreadPool::getPendingCount() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_pendingCount;
+}
+
+int ThreadPool::getThreadCount() const noexcept
+{
+    return (int)m_threads.size();
+}
+
+int ThreadPool::getDefaultThreadCount() noexcept
+{
+    // hardware_concurrency may report 0 when it cannot tell
+    return std::max((int)std::thread::hardware_concurrency() - 1, 1);
+}
+
+void ThreadPool::run()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobPushed.wait(lock,
+                             [this] { return !m_jobs.empty() || !m_isRunning; });
+            if (!m_isRunning) {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        job();
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_pendingCount--;
+        }
+        m_jobFinished.notify_all();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef THREADPOOL_H_INCLUDED
+#define THREADPOOL_H_INCLUDED
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NonCopyable.h"
+
+/**
+ * @class ThreadPool
+ * @brief A fixed number of threads running queued jobs.
+ *
+ * @details
+ * Jobs start in the order they were pushed. Jobs that have not started when
+ * the pool is destroyed are dropped; running ones are waited for.
+ */
+class ThreadPool : public NonCopyable {
+  public:
+    using Job = std::function<void()>;
+
+    /// @param threadCount The number of threads, at least one is started.
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    void push(Job job);
+
+    /// @brief Blocks until every pushed job has finished.
+    void wait();
+
+    /// @brief Gets the number of jobs that are queued or running.
+    int getPendingCount() const;
+
+    int getThreadCount() const noexcept;
+
+    /// @brief Gets a thread count leaving one hardware thread for the caller.
+    static int getDefaultThreadCount() noexcept;
+
+  private:
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::deque<Job> m_jobs;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobPushed;
+    std::condition_variable m_jobFinished;
+
+    int m_pendingCount = 0;
+    bool m_isRunning = true;
+};
+
+#endif // THREADPOOL_H_INCLUDED
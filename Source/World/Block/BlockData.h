@@ -3,7 +3,8 @@
 
 #include "../../Util/NonCopyable.h"
 #include "BlockId.h"
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
 
 /// @brief Allocates meshes to cubes and non-cube entities.
 enum class BlockMeshType {
@@ -1,8 +1,6 @@
 #include "BlockDatabase.h"
 
-// Block Database initializes to first pack, not the second.
 BlockDatabase::BlockDatabase()
-    : textureAtlas("DefaultPack")
 {
     m_blocks[(int)BlockId::Air] = std::make_unique<DefaultBlock>("Air");
     m_blocks[(int)BlockId::Grass] = std::make_unique<DefaultBlock>("Grass");
@@ -9,9 +9,13 @@
 #include "BlockId.h"
 #include "BlockTypes/BlockType.h"
 
-#include "../../Texture/TextureAtlas.h"
-
-/// @brief Singleton class that determines status and ID of blocks as a whole.
+/**
+ * @brief Singleton class that determines status and ID of blocks as a whole.
+ *
+ * @details
+ * Holds only the block data, which generation and meshing read. The block
+ * textures belong to the renderer, so none of this needs a GL context.
+ */
 class BlockDatabase : public Singleton {
   public:
     static BlockDatabase &get();
@@ -19,8 +23,6 @@ class BlockDatabase : public Singleton {
     const BlockType &getBlock(BlockId id) const;
     const BlockData &getData(BlockId id) const;
 
-    TextureAtlas textureAtlas;
-
   private:
     BlockDatabase();
 
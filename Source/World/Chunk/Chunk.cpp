@@ -2,11 +2,21 @@
 
 #include "../../Camera.h"
 #include "../../Maths/NoiseGenerator.h"
-#include "../../Renderer/RenderMaster.h"
 #include "../../Util/Random.h"
 #include "../Generation/Terrain/TerrainGenerator.h"
 #include "../World.h"
 
+#include <mutex>
+
+namespace {
+// Taken to change any chunk or section link, and the sections of a chunk in
+// a world, as linking a section writes to the sections around it whichever
+// chunk they are in
+std::mutex linkMutex;
+} // namespace
+
+LockStatistics Chunk::s_lockStatistics;
+
 Chunk::Chunk(World &world, const sf::Vector2i &location)
     : m_location(location)
     , m_pWorld(&world)
@@ -14,27 +24,69 @@ Chunk::Chunk(World &world, const sf::Vector2i &location)
     m_highestBlocks.setAll(0);
 }
 
-bool Chunk::makeMesh(const Camera &camera)
+Chunk::Chunk(const sf::Vector2i &location)
+    : m_location(location)
 {
-    for (auto &chunk : m_chunks) {
-        if (!chunk.hasMesh() &&
-            camera.getFrustum().isBoxInFrustum(chunk.m_aabb)) {
-            chunk.makeMesh();
-            return true;
+    m_highestBlocks.setAll(0);
+}
+
+Chunk::~Chunk()
+{
+    // Chunks outside of any world are only linked within themselves
+    std::unique_lock<std::mutex> lock(linkMutex, std::defer_lock);
+    if (m_pWorld) {
+        lock.lock();
+    }
+    unlinkSections();
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dz = -1; dz <= 1; dz++) {
+            if (Chunk *chunk = getNeighbour(dx, dz)) {
+                chunk->m_neighbours[neighbourIndex(-dx, -dz)] = nullptr;
+            }
         }
     }
-    return false;
+}
+
+int Chunk::makeMeshes()
+{
+    int queued = 0;
+    for (int i = m_minSection; i <= m_maxSection; i++) {
+        ChunkSection *section = m_sections[i].get();
+        if (section && !section->hasMesh() && !section->isMeshQueued()) {
+            m_pWorld->queueMesh(*section);
+            queued++;
+        }
+    }
+    return queued;
 }
 
 void Chunk::setBlock(int x, int y, int z, ChunkBlock block)
 {
-    addSectionsBlockTarget(y);
     if (outOfBound(x, y, z)) {
         return;
     }
 
+    int index = y / CHUNK_SIZE;
+    ChunkSection *section = findSection(index);
+    if (!section) {
+        // Missing sections already read as air
+        if (block == BlockId::Air) {
+            return;
+        }
+        section = &addSection(index);
+    }
+
     int bY = y % CHUNK_SIZE;
-    m_chunks[y / CHUNK_SIZE].setBlock(x, bY, z, block);
+    section->setBlock(x, bY, z, block);
+
+    if (block != BlockId::Air) {
+        includeSection(index);
+    }
+    else if (section->isUniform() &&
+             (index == m_minSection || index == m_maxSection)) {
+        updateSectionBounds();
+    }
 
     if (y == m_highestBlocks.get(x, z)) {
         auto highBlock = getBlock(x, y--, z);
@@ -46,11 +98,73 @@ void Chunk::setBlock(int x, int y, int z, ChunkBlock block)
         m_highestBlocks.get(x, z) = y;
     }
 
-    if (m_isLoaded) {
+    if (hasLoaded()) {
         // m_pWorld->updateChunk(x, y, z);
     }
 }
 
+void Chunk::fillBox(int minX, int minY, int minZ, int maxX, int maxY, int maxZ,
+                    ChunkBlock block)
+{
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    minZ = std::max(minZ, 0);
+    maxX = std::min(maxX, CHUNK_SIZE);
+    maxY = std::min(maxY, WORLD_HEIGHT);
+    maxZ = std::min(maxZ, CHUNK_SIZE);
+    if (minX >= maxX || minY >= maxY || minZ >= maxZ) {
+        return;
+    }
+
+    bool isAir = block == BlockId::Air;
+    bool isSectionEmptied = false;
+
+    for (int index = minY / CHUNK_SIZE; index <= (maxY - 1) / CHUNK_SIZE; index++) {
+        ChunkSection *section = findSection(index);
+        if (!section) {
+            // Missing sections already read as air
+            if (isAir) {
+                continue;
+            }
+            section = &addSection(index);
+        }
+
+        int base = index * CHUNK_SIZE;
+        section->fillBox(minX, std::max(minY - base, 0), minZ, maxX,
+                         std::min(maxY - base, CHUNK_SIZE), maxZ, block);
+
+        if (!isAir) {
+            includeSection(index);
+        }
+        else if (section->isUniform()) {
+            isSectionEmptied = true;
+        }
+    }
+
+    if (isSectionEmptied) {
+        updateSectionBounds();
+    }
+
+    // As with setBlock, the highest blocks only ever rise here
+    if (!isAir) {
+        for (int x = minX; x < maxX; x++)
+            for (int z = minZ; z < maxZ; z++) {
+                auto &highest = m_highestBlocks.get(x, z);
+                highest = std::max(highest, maxY - 1);
+            }
+    }
+}
+
+void Chunk::fillColumn(int x, int z, int minY, int maxY, ChunkBlock block)
+{
+    fillBox(x, minY, z, x + 1, maxY, z + 1, block);
+}
+
+void Chunk::fillLayer(int y, ChunkBlock block)
+{
+    fillBox(0, y, 0, CHUNK_SIZE, y + 1, CHUNK_SIZE, block);
+}
+
 // Chunk block to SECTION BLOCK positions
 ChunkBlock Chunk::getBlock(int x, int y, int z) const noexcept
 {
@@ -58,9 +172,14 @@ ChunkBlock Chunk::getBlock(int x, int y, int z) const noexcept
         return BlockId::Air;
     }
 
+    const ChunkSection *section = findSection(y / CHUNK_SIZE);
+    if (!section) {
+        return BlockId::Air;
+    }
+
     int bY = y % CHUNK_SIZE;
 
-    return m_chunks[y / CHUNK_SIZE].getBlock(x, bY, z);
+    return section->getBlock(x, bY, z);
 }
 
 int Chunk::getHeightAt(int x, int z)
@@ -68,7 +187,7 @@ int Chunk::getHeightAt(int x, int z)
     return m_highestBlocks.get(x, z);
 }
 
-bool Chunk::outOfBound(int x, int y, int z) const noexcept
+bool Chunk::outOfBound(int x, int y, int z) noexcept
 {
     if (x >= CHUNK_SIZE)
         return true;
@@ -82,74 +201,272 @@ bool Chunk::outOfBound(int x, int y, int z) const noexcept
     if (z < 0)
         return true;
 
-    if (y >= (int)m_chunks.size() * CHUNK_SIZE) {
+    if (y >= WORLD_HEIGHT)
         return true;
-    }
 
     return false;
 }
 
-void Chunk::drawChunks(RenderMaster &renderer, const Camera &camera)
+void Chunk::drawChunks(IChunkRenderer &renderer, const Camera &camera)
 {
-    for (auto &chunk : m_chunks) {
-        if (chunk.hasMesh()) {
-            if (!chunk.hasBuffered()) {
-                chunk.bufferMesh();
+    for (int i = m_minSection; i <= m_maxSection; i++) {
+        ChunkSection *section = m_sections[i].get();
+        if (section && section->hasMesh()) {
+            // Only meshes rebuilt on this thread after an edit are left to
+            // buffer here; the workers' meshes are uploaded by the world
+            if (!section->hasBuffered()) {
+                section->bufferMesh(renderer);
             }
 
-            if (camera.getFrustum().isBoxInFrustum(chunk.m_aabb))
-                renderer.drawChunk(chunk);
+            if (camera.getFrustum().isBoxInFrustum(section->m_aabb))
+                renderer.drawChunk(section->getMeshHandle());
         }
     }
 }
 
 bool Chunk::hasLoaded() const noexcept
 {
-    return m_isLoaded;
+    return m_status.load() >= ChunkStatus::Decorated;
 }
 
-void Chunk::load(TerrainGenerator &generator)
+void Chunk::load(const TerrainGenerator &generator)
 {
     if (hasLoaded())
         return;
 
     generator.generateTerrainFor(*this);
-    m_isLoaded = true;
+    m_status = ChunkStatus::Decorated;
+}
+
+ChunkStatus Chunk::getStatus() const noexcept
+{
+    if (!hasLoaded()) {
+        return m_status;
+    }
+
+    ChunkStatus status = ChunkStatus::Uploaded;
+    for (int i = m_minSection; i <= m_maxSection; i++) {
+        const ChunkSection *section = m_sections[i].get();
+        if (!section) {
+            continue;
+        }
+        if (!section->hasMesh()) {
+            return ChunkStatus::Decorated;
+        }
+        if (!section->hasBuffered()) {
+            status = ChunkStatus::Meshed;
+        }
+    }
+    return status;
+}
+
+void Chunk::generateStage(const TerrainGenerator &generator, ChunkStatus stage)
+{
+    generator.generateStage(stage, *this);
+    m_status = stage;
+}
+
+void Chunk::takeTerrain(Chunk &generated)
+{
+    std::unique_lock<std::mutex> lock(linkMutex);
+    unlinkSections();
+
+    m_sections = std::move(generated.m_sections);
+    generated.m_sections.clear();
+
+    m_minSection = generated.m_minSection;
+    m_maxSection = generated.m_maxSection;
+    m_highestBlocks = generated.m_highestBlocks;
+
+    for (int i = 0; i < (int)m_sections.size(); i++) {
+        if (m_sections[i]) {
+            m_sections[i]->m_pWorld = m_pWorld;
+            linkSection(i);
+        }
+    }
+    m_status = ChunkStatus::Decorated;
+}
+
+std::vector<std::unique_ptr<ChunkSection>> Chunk::releaseSections()
+{
+    std::unique_lock<std::mutex> lock(linkMutex, std::defer_lock);
+    if (m_pWorld) {
+        lock.lock();
+    }
+    unlinkSections();
+
+    auto sections = std::move(m_sections);
+    m_sections.clear();
+    m_minSection = 0;
+    m_maxSection = -1;
+    return sections;
 }
 
 ChunkSection &Chunk::getSection(int index)
 {
-    static ChunkSection errorSection({444, 444, 444}, *m_pWorld);
+    static ChunkSection errorSection({444, 444, 444}, m_pWorld);
 
-    if (index >= (int)m_chunks.size() || index < 0)
+    if (index < 0 || index >= CHUNK_SECTIONS)
         return errorSection;
 
-    return m_chunks[index];
+    if (ChunkSection *section = findSection(index)) {
+        return *section;
+    }
+    return addSection(index);
+}
+
+ChunkSection *Chunk::findSection(int index) const noexcept
+{
+    if (index >= (int)m_sections.size() || index < 0)
+        return nullptr;
+
+    return m_sections[index].get();
+}
+
+std::size_t Chunk::getMemoryUsage() const noexcept
+{
+    std::size_t bytes =
+        sizeof(*this) + m_sections.capacity() * sizeof(m_sections[0]);
+    for (int i = m_minSection; i <= m_maxSection; i++) {
+        if (m_sections[i]) {
+            bytes += m_sections[i]->getMemoryUsage();
+        }
+    }
+    return bytes;
 }
 
 void Chunk::deleteMeshes()
 {
-    for (unsigned i = 0; i < m_chunks.size(); i++) {
-        m_chunks[i].deleteMeshes();
+    for (auto &section : m_sections) {
+        if (section) {
+            section->deleteMeshes();
+        }
     }
 }
 
-void Chunk::addSection()
+CountedSharedMutex &Chunk::getMutex() const noexcept
 {
-    int y = m_chunks.size();
-    m_chunks.emplace_back(sf::Vector3i(m_location.x, y, m_location.y),
-                          *m_pWorld);
+    return m_mutex;
 }
 
-void Chunk::addSectionsBlockTarget(int blockY)
+LockStatistics::Totals Chunk::takeLockStatistics() noexcept
 {
-    int index = blockY / CHUNK_SIZE;
-    addSectionsIndexTarget(index);
+    return s_lockStatistics.take();
 }
 
-void Chunk::addSectionsIndexTarget(int index)
+Chunk *Chunk::getNeighbour(int dx, int dz) const noexcept
 {
-    while ((int)m_chunks.size() < index + 1) {
-        addSection();
+    return m_neighbours[neighbourIndex(dx, dz)];
+}
+
+void Chunk::linkNeighbour(int dx, int dz, Chunk &chunk)
+{
+    std::unique_lock<std::mutex> lock(linkMutex);
+
+    m_neighbours[neighbourIndex(dx, dz)] = &chunk;
+    chunk.m_neighbours[neighbourIndex(-dx, -dz)] = this;
+
+    if (dx != 0 && dz != 0) {
+        return;
+    }
+
+    auto direction = dx != 0 ? (dx < 0 ? ChunkSection::NegX : ChunkSection::PosX)
+                             : (dz < 0 ? ChunkSection::NegZ : ChunkSection::PosZ);
+
+    int count = (int)std::min(m_sections.size(), chunk.m_sections.size());
+    for (int i = 0; i < count; i++) {
+        ChunkSection *section = m_sections[i].get();
+        ChunkSection *other = chunk.m_sections[i].get();
+        if (section && other) {
+            section->linkNeighbour(direction, other);
+        }
+    }
+}
+
+int Chunk::neighbourIndex(int dx, int dz) noexcept
+{
+    return (dz + 1) * 3 + (dx + 1);
+}
+
+// Links a newly created section to the sections around it
+void Chunk::linkSection(int index)
+{
+    ChunkSection &section = *m_sections[index];
+
+    section.linkNeighbour(ChunkSection::NegY, findSection(index - 1));
+    section.linkNeighbour(ChunkSection::PosY, findSection(index + 1));
+
+    auto linkAdjacent = [&](ChunkSection::Neighbour direction, int dx, int dz) {
+        if (const Chunk *chunk = getNeighbour(dx, dz)) {
+            section.linkNeighbour(direction, chunk->findSection(index));
+        }
+    };
+    linkAdjacent(ChunkSection::NegX, -1, 0);
+    linkAdjacent(ChunkSection::PosX, 1, 0);
+    linkAdjacent(ChunkSection::NegZ, 0, -1);
+    linkAdjacent(ChunkSection::PosZ, 0, 1);
+}
+
+ChunkSection &Chunk::addSection(int index)
+{
+    std::unique_lock<std::mutex> lock(linkMutex, std::defer_lock);
+    if (m_pWorld) {
+        lock.lock();
+    }
+
+    if (index >= (int)m_sections.size()) {
+        m_sections.resize(index + 1);
+    }
+
+    auto &section = m_sections[index];
+    section = std::make_unique<ChunkSection>(
+        sf::Vector3i(m_location.x, index, m_location.y), m_pWorld);
+
+    linkSection(index);
+    includeSection(index);
+    return *section;
+}
+
+// Clears the links of every section, to and from the sections around it
+void Chunk::unlinkSections()
+{
+    for (auto &section : m_sections) {
+        if (section) {
+            for (int i = 0; i < ChunkSection::NUM_NEIGHBOURS; i++) {
+                section->linkNeighbour(static_cast<ChunkSection::Neighbour>(i),
+                                       nullptr);
+            }
+        }
+    }
+}
+
+void Chunk::includeSection(int index)
+{
+    if (m_maxSection < m_minSection) {
+        m_minSection = m_maxSection = index;
+    }
+    else {
+        m_minSection = std::min(m_minSection, index);
+        m_maxSection = std::max(m_maxSection, index);
+    }
+}
+
+// Narrows the occupied range after its lowest or highest section was emptied
+void Chunk::updateSectionBounds()
+{
+    m_minSection = 0;
+    m_maxSection = -1;
+
+    for (int i = 0; i < (int)m_sections.size(); i++) {
+        const ChunkSection *section = m_sections[i].get();
+        if (!section || (section->isUniform() &&
+                         section->getUniformBlock() == BlockId::Air)) {
+            continue;
+        }
+
+        if (m_maxSection < m_minSection) {
+            m_minSection = i;
+        }
+        m_maxSection = i;
     }
 }
@@ -2,33 +2,164 @@
 #define CHUNK_H_INCLUDED
 
 #include "../../Util/Array2D.h"
+#include "../../Util/LockStatistics.h"
 #include "../../Util/NonCopyable.h"
 #include "ChunkSection.h"
+#include "ChunkStatus.h"
+#include "IChunkRenderer.h"
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 
-class RenderMaster;
 class Camera;
 class TerrainGenerator;
 
-/// @brief A chunk, in other words, a large arrangement of blocks.
+/**
+ * @class Chunk
+ * @brief A chunk, in other words, a large arrangement of blocks.
+ *
+ * @details
+ * A chunk is a vertical column of chunk sections. Sections are stored
+ * sparsely: a section is only created once a non-air block is written into
+ * it, and missing sections read as air. The range of occupied sections is
+ * tracked so meshing and drawing only visit sections that hold blocks.
+ *
+ * Each chunk links to its eight horizontal neighbours, and each section to
+ * its six face neighbours, so neighbours can be reached without going through
+ * the ChunkManager. Links are made when a chunk or section is created and are
+ * cleared again when it is destroyed.
+ *
+ * Chunks in a world are shared between the main thread and the chunk loader,
+ * so each has its own lock, see getMutex. The links are atomic and read
+ * without any lock; they are only changed while holding a lock shared by
+ * every chunk, as linking a section writes to sections of other chunks.
+ */
 class Chunk : public IChunk {
   public:
     Chunk() = default;
     Chunk(World &world, const sf::Vector2i &location);
 
-    bool makeMesh(const Camera &camera);
+    /**
+     * @brief Creates a chunk outside of any world.
+     *
+     * @details
+     * Used to generate terrain without a world, as the GenerationPipeline
+     * does when it has none. Such a chunk can not be meshed, and blocks its
+     * sections write or read beyond their edges are dropped or read as air.
+     */
+    explicit Chunk(const sf::Vector2i &location);
+    ~Chunk();
+
+    /**
+     * @brief Queues a mesh for every section that has neither a mesh nor
+     * one queued.
+     *
+     * @return The number of meshes queued.
+     */
+    int makeMeshes();
 
     void setBlock(int x, int y, int z, ChunkBlock block) override;
     ChunkBlock getBlock(int x, int y, int z) const noexcept override;
-    int getHeightAt(int x, int z);
 
-    void drawChunks(RenderMaster &renderer, const Camera &camera);
+    /**
+     * @brief Sets every block in a box to the same block.
+     *
+     * @details
+     * The box runs from (minX, minY, minZ) up to but not including
+     * (maxX, maxY, maxZ); the parts outside the chunk are ignored. The box is
+     * written into each section it crosses in one go, and the section range
+     * and the highest blocks are updated once for the whole box rather than
+     * for every block.
+     */
+    void fillBox(int minX, int minY, int minZ, int maxX, int maxY, int maxZ,
+                 ChunkBlock block);
+
+    /// @brief Sets the blocks from minY up to but not including maxY in one
+    /// column.
+    void fillColumn(int x, int z, int minY, int maxY, ChunkBlock block);
+
+    /// @brief Sets every block in a layer.
+    void fillLayer(int y, ChunkBlock block);
+    int getHeightAt(int x, int z);
 
+    /// @brief Buffers the meshes that are not yet and draws the sections in
+    /// view.
+    void drawChunks(IChunkRenderer &renderer, const Camera &camera);
+
+    /**
+     * @brief Gets the lock guarding the blocks, sections and meshes.
+     *
+     * @details
+     * Hold it shared to read blocks, and exclusively to change blocks or
+     * meshes, or to queue a mesh. Several chunks are locked at once with a
+     * ChunkAreaLock only, so they are always locked in the same order. The
+     * status can be read without it. Chunks generated outside of any world
+     * are only used by one thread at a time and need not be locked.
+     */
+    CountedSharedMutex &getMutex() const noexcept;
+
+    /// @brief Returns the statistics of every chunk lock taken since the
+    /// last call, and resets them.
+    static LockStatistics::Totals takeLockStatistics() noexcept;
+
+    /// @brief Whether every generation stage has run, up to Decorated.
     bool hasLoaded() const noexcept;
-    void load(TerrainGenerator &generator);
-
+    void load(const TerrainGenerator &generator);
+
+    /**
+     * @brief Gets how far the chunk has come.
+     *
+     * @details
+     * Up to Decorated this is the last generation stage run. After that the
+     * chunk is Meshed once every section holding blocks has a mesh, and
+     * Uploaded once every one of those meshes is buffered.
+     */
+    ChunkStatus getStatus() const noexcept;
+
+    /// @brief Runs one generation stage, which must be the one after the
+    /// current status.
+    void generateStage(const TerrainGenerator &generator, ChunkStatus stage);
+
+    /**
+     * @brief Loads the chunk with the terrain of another chunk.
+     *
+     * @details
+     * Used to fill a stored chunk with terrain that the GenerationPipeline
+     * generated into an unlinked chunk at the same location, away from the
+     * world lock. The
+     * sections are moved over, replacing any this chunk had, and moved into
+     * the world of this chunk and linked to its neighbours.
+     */
+    void takeTerrain(Chunk &generated);
+
+    /**
+     * @brief Takes every section out of the chunk, leaving it empty.
+     *
+     * @details
+     * The sections are unlinked from the sections around them first, so
+     * they can be destroyed on any thread once their meshes are released.
+     * Used to tear a chunk down away from the main thread when it unloads.
+     */
+    std::vector<std::unique_ptr<ChunkSection>> releaseSections();
+
+    /**
+     * @brief Gets the section at the given index, creating it if needed.
+     *
+     * @details
+     * Used when a section is about to be edited. Read-only lookups should use
+     * findSection, which does not create anything.
+     */
     ChunkSection &getSection(int index);
 
+    /// @brief Gets the section at the given index, or nullptr if it is air.
+    ChunkSection *findSection(int index) const noexcept;
+
+    /// @brief Gets the number of bytes used by the chunk and its sections,
+    /// not counting their meshes.
+    std::size_t getMemoryUsage() const noexcept;
+
     const sf::Vector2i &getLocation() const
     {
         return m_location;
@@ -36,20 +167,52 @@ class Chunk : public IChunk {
 
     void deleteMeshes();
 
+    /**
+     * @brief Gets the neighbouring chunk at the given offset.
+     *
+     * @param dx The x offset, in the range [-1, 1].
+     * @param dz The z offset, in the range [-1, 1].
+     *
+     * @return The neighbour, or nullptr if it is not loaded.
+     */
+    Chunk *getNeighbour(int dx, int dz) const noexcept;
+
+    /**
+     * @brief Links this chunk and the chunk at the given offset to each other.
+     *
+     * @details
+     * For face neighbours, the sections of both chunks at the same height are
+     * linked too. Called by the chunk storage when a chunk is created.
+     */
+    void linkNeighbour(int dx, int dz, Chunk &chunk);
+
   private:
-    void addSection();
-    void addSectionsBlockTarget(int blockY);
-    void addSectionsIndexTarget(int index);
+    static int neighbourIndex(int dx, int dz) noexcept;
+    void linkSection(int index);
+
+    ChunkSection &addSection(int index);
+    void unlinkSections();
+    void includeSection(int index);
+    void updateSectionBounds();
+
+    static bool outOfBound(int x, int y, int z) noexcept;
 
-    bool outOfBound(int x, int y, int z) const noexcept;
+    std::vector<std::unique_ptr<ChunkSection>> m_sections;
+    int m_minSection = 0;
+    int m_maxSection = -1;
+
+    // Indexed by neighbourIndex(dx, dz); the centre entry is always nullptr
+    std::array<std::atomic<Chunk *>, 9> m_neighbours{};
 
-    std::vector<ChunkSection> m_chunks;
     Array2D<int, CHUNK_SIZE> m_highestBlocks;
     sf::Vector2i m_location;
 
-    World *m_pWorld;
+    World *m_pWorld = nullptr;
+
+    std::atomic<ChunkStatus> m_status{ChunkStatus::Empty};
 
-    bool m_isLoaded = false;
+    static LockStatistics s_lockStatistics;
+    mutable CountedSharedMutex m_mutex{s_lockStatistics};
 };
 
 #endif // CHUNK_H_INCLUDED
@@ -0,0 +1,37 @@
+#include "ChunkAreaLock.h"
+
+#include "Chunk.h"
+
+namespace {
+constexpr int CENTRE = 4;
+} // namespace
+
+ChunkAreaLock::ChunkAreaLock(Chunk &centre)
+{
+    int i = 0;
+    for (int dz = -1; dz <= 1; dz++)
+        for (int dx = -1; dx <= 1; dx++) {
+            Chunk *chunk = i == CENTRE ? &centre : centre.getNeighbour(dx, dz);
+            m_chunks[i] = chunk;
+
+            if (chunk && i == CENTRE) {
+                chunk->getMutex().lock();
+            }
+            else if (chunk) {
+                chunk->getMutex().lock_shared();
+            }
+            i++;
+        }
+}
+
+ChunkAreaLock::~ChunkAreaLock()
+{
+    for (int i = (int)m_chunks.size() - 1; i >= 0; i--) {
+        if (m_chunks[i] && i == CENTRE) {
+            m_chunks[i]->getMutex().unlock();
+        }
+        else if (m_chunks[i]) {
+            m_chunks[i]->getMutex().unlock_shared();
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef CHUNKAREALOCK_H_INCLUDED
+#define CHUNKAREALOCK_H_INCLUDED
+
+#include <array>
+
+#include "../../Util/NonCopyable.h"
+
+class Chunk;
+
+/**
+ * @class ChunkAreaLock
+ * @brief Locks a chunk for writing and its loaded neighbours for reading.
+ *
+ * @details
+ * Taken around meshing a section, which reads the blocks around it in the
+ * neighbouring chunks and marks the section as meshed. The chunks are always
+ * locked in order of their position, z first, so threads locking areas that
+ * overlap never wait on each other in a circle.
+ *
+ * The neighbours are the ones linked when the lock is taken. The caller
+ * makes sure none of them is unloaded while it is held.
+ */
+class ChunkAreaLock : public NonCopyable {
+  public:
+    explicit ChunkAreaLock(Chunk &centre);
+    ~ChunkAreaLock();
+
+  private:
+    // In locking order; the centre is at index 4
+    std::array<Chunk *, 9> m_chunks{};
+};
+
+#endif // CHUNKAREALOCK_H_INCLUDED
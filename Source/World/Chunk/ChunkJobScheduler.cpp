@@ -0,0 +1,164 @@
+#include "ChunkJobScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "../WorldConstants.h"
+
+ChunkJobScheduler::ChunkJobScheduler(int threadCount)
+{
+    for (int i = 0; i < std::max(threadCount, 1); i++) {
+        m_threads.emplace_back([this] { run(); });
+    }
+}
+
+ChunkJobScheduler::~ChunkJobScheduler()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+        m_queue.clear();
+    }
+    m_jobPushed.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ChunkJobScheduler::push(const AABB &bounds, Task job, Task cancel)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queue.push_back({bounds.position, bounds.dimensions, std::move(job),
+                           std::move(cancel),
+                           getPriority(bounds.position, bounds.dimensions),
+                           m_nextSequence++});
+        std::push_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+
+        m_statistics.peakQueued =
+            std::max(m_statistics.peakQueued, (int)m_queue.size());
+    }
+    m_jobPushed.notify_one();
+}
+
+void ChunkJobScheduler::setFocus(const glm::vec3 &position,
+                                 const ViewFrustum &frustum, int radius)
+{
+    std::vector<Task> cancelled;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_focus = position;
+        m_frustum = frustum;
+        m_hasFocus = true;
+
+        // Truncated the same way as the centre of the chunk storage
+        int chunkX = (int)position.x / CHUNK_SIZE;
+        int chunkZ = (int)position.z / CHUNK_SIZE;
+        auto isOutOfRange = [&](const Entry &entry) {
+            int x = (int)entry.position.x / CHUNK_SIZE;
+            int z = (int)entry.position.z / CHUNK_SIZE;
+            return std::abs(x - chunkX) > radius || std::abs(z - chunkZ) > radius;
+        };
+
+        auto kept = m_queue.begin();
+        for (auto &entry : m_queue) {
+            if (isOutOfRange(entry)) {
+                cancelled.push_back(std::move(entry.cancel));
+                continue;
+            }
+
+            entry.priority = getPriority(entry.position, entry.dimensions);
+            if (&*kept != &entry) {
+                *kept = std::move(entry);
+            }
+            ++kept;
+        }
+        m_queue.erase(kept, m_queue.end());
+        std::make_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+
+        m_statistics.cancelled += (int)cancelled.size();
+    }
+
+    // Outside the lock, as they may take locks of their own
+    for (auto &cancel : cancelled) {
+        if (cancel) {
+            cancel();
+        }
+    }
+}
+
+int ChunkJobScheduler::getPendingCount() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return (int)m_queue.size() + m_runningCount;
+}
+
+int ChunkJobScheduler::getThreadCount() const noexcept
+{
+    return (int)m_threads.size();
+}
+
+ChunkJobScheduler::Statistics ChunkJobScheduler::takeStatistics()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Statistics taken = m_statistics;
+    taken.queued = (int)m_queue.size();
+
+    m_statistics = {};
+    m_statistics.peakQueued = (int)m_queue.size();
+    return taken;
+}
+
+float ChunkJobScheduler::getPriority(const glm::vec3 &position,
+                                     const glm::vec3 &dimensions) const noexcept
+{
+    if (!m_hasFocus) {
+        return 0.0f;
+    }
+
+    glm::vec3 offset = position + dimensions * 0.5f - m_focus;
+    float distanceSquared = glm::dot(offset, offset);
+
+    AABB bounds(dimensions);
+    bounds.update(position);
+
+    // Twice as far away, squared
+    return m_frustum.isBoxInFrustum(bounds) ? distanceSquared
+                                            : distanceSquared * 4.0f;
+}
+
+bool ChunkJobScheduler::isLessUrgent(const Entry &a, const Entry &b) noexcept
+{
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.sequence > b.sequence;
+}
+
+void ChunkJobScheduler::run()
+{
+    while (true) {
+        Task job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobPushed.wait(lock,
+                             [this] { return !m_queue.empty() || !m_isRunning; });
+            if (!m_isRunning) {
+                return;
+            }
+
+            std::pop_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+            job = std::move(m_queue.back().job);
+            m_queue.pop_back();
+
+            m_runningCount++;
+            m_statistics.started++;
+        }
+
+        job();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_runningCount--;
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef CHUNKJOBSCHEDULER_H_INCLUDED
+#define CHUNKJOBSCHEDULER_H_INCLUDED
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../Maths/Frustum.h"
+#include "../../Physics/AABB.h"
+#include "../../Util/NonCopyable.h"
+
+/**
+ * @class ChunkJobScheduler
+ * @brief Runs jobs on chunks on its own workers, nearest and visible first.
+ *
+ * @details
+ * Each job covers a box of the world, such as the column of a chunk being
+ * generated or a section being meshed. Jobs are started in order of the
+ * distance of their box to the focus set with setFocus, with boxes outside
+ * the view counting as twice as far away. Until a focus is set, and between
+ * jobs as urgent as each other, they start in the order they were pushed.
+ *
+ * The waiting jobs are kept in a heap, so moving the focus recomputes their
+ * priorities and rebuilds the heap in one pass, which also cancels the jobs
+ * that have fallen out of range. Jobs that have started always finish.
+ */
+class ChunkJobScheduler : public NonCopyable {
+  public:
+    using Task = std::function<void()>;
+
+    struct Statistics {
+        int queued = 0;     // Jobs waiting when the statistics were taken
+        int peakQueued = 0; // The most jobs waiting at once
+        int started = 0;
+        int cancelled = 0;
+    };
+
+    /// @param threadCount The number of workers, at least one is started.
+    explicit ChunkJobScheduler(int threadCount);
+    ~ChunkJobScheduler();
+
+    /**
+     * @brief Queues a job.
+     *
+     * @param bounds The part of the world the job works on.
+     * @param cancel Called instead of the job if it is cancelled, on the
+     *               thread calling setFocus.
+     */
+    void push(const AABB &bounds, Task job, Task cancel = {});
+
+    /**
+     * @brief Reorders the waiting jobs around a new camera position and view.
+     *
+     * @param radius Jobs whose box starts more than this many chunks away
+     *               from the chunk of the position, on either axis, are
+     *               cancelled.
+     */
+    void setFocus(const glm::vec3 &position, const ViewFrustum &frustum,
+                  int radius);
+
+    /// @brief Gets the number of jobs that are queued or running.
+    int getPendingCount() const;
+
+    int getThreadCount() const noexcept;
+
+    /// @brief Returns the statistics gathered so far and resets them.
+    Statistics takeStatistics();
+
+  private:
+    // The box is kept as plain vectors, as an AABB can not be reassigned
+    struct Entry {
+        glm::vec3 position;
+        glm::vec3 dimensions;
+        Task job;
+        Task cancel;
+        float priority;
+        uint64_t sequence;
+    };
+
+    // Lower is more urgent
+    float getPriority(const glm::vec3 &position,
+                      const glm::vec3 &dimensions) const noexcept;
+    static bool isLessUrgent(const Entry &a, const Entry &b) noexcept;
+
+    void run();
+
+    std::vector<std::thread> m_threads;
+
+    // A heap with the most urgent job at the front
+    std::vector<Entry> m_queue;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobPushed;
+
+    glm::vec3 m_focus{0.0f};
+    ViewFrustum m_frustum;
+    bool m_hasFocus = false;
+
+    Statistics m_statistics;
+    uint64_t m_nextSequence = 0;
+    int m_runningCount = 0;
+    bool m_isRunning = true;
+};
+
+#endif // CHUNKJOBSCHEDULER_H_INCLUDED
@@ -1,67 +1,253 @@
 #include "ChunkManager.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 
 #include "../Generation/Terrain/ClassicOverWorldGenerator.h"
 #include "../Generation/Terrain/SuperFlatGenerator.h"
+#include "ChunkAreaLock.h"
+#include "HashedChunkStorage.h"
+#include "RingChunkStorage.h"
 
-ChunkManager::ChunkManager(World &world)
+ChunkManager::ChunkManager(World &world, const Config &config)
     : m_world(&world)
+    , m_outOfRangeChunk(world, {0, 0})
+    , m_loadDistance(config.renderDistance + 1)
+    , m_unloadDistance(m_loadDistance + std::max(config.unloadMargin - 1, 0))
+    , m_coldChunks((std::size_t)std::max(config.coldCacheMiB, 0) * 1024 * 1024)
 {
+    if (config.ringChunkStorage) {
+        m_chunks = std::make_unique<RingChunkStorage>(m_unloadDistance);
+    }
+    else {
+        m_chunks = std::make_unique<HashedChunkStorage>(m_unloadDistance);
+    }
     m_terrainGenerator = std::make_unique<ClassicOverWorldGenerator>();
+    m_generationPipeline = std::make_unique<GenerationPipeline>(
+        world, *m_terrainGenerator, config.generationWorkers);
 }
 
 Chunk &ChunkManager::getChunk(int x, int z)
 {
-    VectorXZ key{x, z};
-    if (!chunkExistsAt(x, z)) {
-        Chunk chunk{*m_world, {x, z}};
-        m_chunks.emplace(key, std::move(chunk));
+    Chunk *chunk = tryGetChunk(x, z);
+    return chunk ? *chunk : m_outOfRangeChunk;
+}
+
+Chunk *ChunkManager::tryGetChunk(int x, int z)
+{
+    if (Chunk *chunk = findChunk(x, z)) {
+        return chunk;
+    }
+
+    std::unique_lock<CountedSharedMutex> lock(m_mapMutex);
+    Chunk *chunk = m_chunks->findOrCreate(x, z, *m_world);
+    if (chunk) {
+        m_index.tryEmplace(x, z, chunk);
+    }
+    return chunk;
+}
+
+const Chunk *ChunkManager::findChunk(int x, int z) const noexcept
+{
+    Chunk *const *chunk = m_index.find(x, z);
+    return chunk ? *chunk : nullptr;
+}
+
+Chunk *ChunkManager::findChunk(int x, int z) noexcept
+{
+    Chunk *const *chunk = m_index.find(x, z);
+    return chunk ? *chunk : nullptr;
+}
+
+Chunk *ChunkManager::findStoredChunk(int x, int z) noexcept
+{
+    return m_chunks->find(x, z);
+}
+
+void ChunkManager::forEachChunk(const std::function<void(Chunk &)> &function)
+{
+    m_index.forEach([&](Chunk *chunk) { function(*chunk); });
+}
+
+void ChunkManager::setCentre(int x, int z)
+{
+    // Called every frame, so the map is only locked when the centre moves
+    if (!m_hasCentre || x != m_centreX || z != m_centreZ) {
+        std::unique_lock<CountedSharedMutex> lock(m_mapMutex);
+
+        // Only the chunks the storage drops are visited, so with the ring
+        // storage only the rows and columns scrolling out
+        std::vector<RetiredChunk> retired;
+        m_chunks->setCentre(x, z, [&](Chunk &chunk) {
+            auto &location = chunk.getLocation();
+            retireChunk(chunk, retired);
+            m_index.erase(location.x, location.y);
+        });
+        lock.unlock();
+        destroyChunks(std::move(retired));
+
+        m_hasCentre = true;
+        m_centreX = x;
+        m_centreZ = z;
+    }
+    m_generationPipeline->setCentre(x, z, m_loadDistance);
+}
+
+void ChunkManager::updateIndex()
+{
+    std::vector<sf::Vector2i> loaded;
+    m_loadedChunks.takeAll(loaded);
+    if (loaded.empty()) {
+        return;
     }
 
-    return m_chunks[key];
+    // Chunks unloaded since they were queued are no longer stored
+    std::shared_lock<CountedSharedMutex> lock(m_mapMutex);
+    for (auto &location : loaded) {
+        if (Chunk *chunk = m_chunks->find(location.x, location.y)) {
+            m_index.tryEmplace(location.x, location.y, chunk);
+        }
+    }
 }
 
-ChunkMap &ChunkManager::getChunks()
+void ChunkManager::setFocus(const glm::vec3 &position, const ViewFrustum &frustum)
 {
-    return m_chunks;
+    m_generationPipeline->setFocus(position, frustum, m_loadDistance);
 }
 
-bool ChunkManager::makeMesh(int x, int z, const Camera &camera)
+int ChunkManager::getLoadDistance() const noexcept
 {
+    return m_loadDistance;
+}
+
+int ChunkManager::makeMeshes(int x, int z)
+{
+    std::shared_lock<CountedSharedMutex> mapLock(m_mapMutex);
+
+    // Meshes read the blocks of the neighbours at the edges
     for (int nx = -1; nx <= 1; nx++)
         for (int nz = -1; nz <= 1; nz++) {
-            loadChunk(
-                x + nx,
-                z + nz); // getChunk(x + nx, z + nz).load(*m_terrainGenerator);
+            if (!storedChunkLoadedAt(x + nx, z + nz)) {
+                return 0;
+            }
         }
 
-    return getChunk(x, z).makeMesh(camera);
+    Chunk *chunk = findStoredChunk(x, z);
+    if (!chunk) {
+        return 0;
+    }
+
+    ChunkAreaLock lock(*chunk);
+    return chunk->makeMeshes();
 }
 
 bool ChunkManager::chunkLoadedAt(int x, int z) const
 {
-    if (!chunkExistsAt(x, z))
-        return false;
+    const Chunk *chunk = findChunk(x, z);
 
-    return m_chunks.at({x, z}).hasLoaded();
+    return chunk && chunk->hasLoaded();
 }
 
 bool ChunkManager::chunkExistsAt(int x, int z) const
 {
-    return m_chunks.find({x, z}) != m_chunks.end();
+    return findChunk(x, z) != nullptr;
+}
+
+bool ChunkManager::storedChunkLoadedAt(int x, int z)
+{
+    const Chunk *chunk = m_chunks->find(x, z);
+
+    return chunk && chunk->hasLoaded();
 }
 
 void ChunkManager::loadChunk(int x, int z)
 {
-    getChunk(x, z).load(*m_terrainGenerator);
+    if (Chunk *chunk = tryGetChunk(x, z)) {
+        std::unique_lock<CountedSharedMutex> lock(chunk->getMutex());
+        chunk->load(*m_terrainGenerator);
+    }
 }
 
-void ChunkManager::deleteMeshes()
+void ChunkManager::requestChunk(int x, int z)
+{
+    {
+        std::shared_lock<CountedSharedMutex> lock(m_mapMutex);
+        if (storedChunkLoadedAt(x, z)) {
+            return;
+        }
+    }
+
+    if (auto chunk = m_coldChunks.take(x, z)) {
+        std::unique_lock<std::mutex> lock(m_restoredMutex);
+        m_restoredChunks.push_back(std::move(chunk));
+        return;
+    }
+    m_generationPipeline->request(x, z);
+}
+
+std::vector<sf::Vector2i> ChunkManager::loadGeneratedChunks()
 {
-    for (auto &chunk : m_chunks) {
-        chunk.second.deleteMeshes();
+    std::vector<sf::Vector2i> loaded;
+    std::vector<std::unique_ptr<Chunk>> finished;
+    {
+        std::unique_lock<std::mutex> lock(m_restoredMutex);
+        finished.swap(m_restoredChunks);
     }
+
+    // Restored chunks come first, so they load in place of any generated
+    // at the same time, and a chunk unloaded while it was being generated
+    // again is taken from the cache instead
+    std::vector<bool> isRestored(finished.size(), true);
+    for (auto &generated : m_generationPipeline->takeFinished()) {
+        auto &location = generated->getLocation();
+        auto restored = m_coldChunks.take(location.x, location.y);
+        isRestored.push_back(restored != nullptr);
+        finished.push_back(restored ? std::move(restored) : std::move(generated));
+    }
+    if (finished.empty()) {
+        return loaded;
+    }
+
+    std::vector<Chunk *> unplaced;
+    std::unique_lock<CountedSharedMutex> lock(m_mapMutex);
+    int misses = 0;
+    for (int i = 0; i < (int)finished.size(); i++) {
+        auto &location = finished[i]->getLocation();
+        Chunk *chunk = m_chunks->findOrCreate(location.x, location.y, *m_world);
+        if (!chunk) {
+            // Out of the storage's reach since it was requested
+            if (isRestored[i]) {
+                unplaced.push_back(finished[i].get());
+            }
+            continue;
+        }
+        if (!chunk->hasLoaded()) {
+            std::unique_lock<CountedSharedMutex> chunkLock(chunk->getMutex());
+            chunk->takeTerrain(*finished[i]);
+            loaded.push_back(location);
+            m_loadedChunks.push(location);
+            misses += !isRestored[i];
+        }
+    }
+    lock.unlock();
+
+    // Put back with their edits, for when the camera returns
+    for (Chunk *chunk : unplaced) {
+        m_coldChunks.putBack(*chunk);
+    }
+    m_coldChunks.recordMisses(misses);
+    return loaded;
+}
+
+void ChunkManager::deleteMeshes()
+{
+    forEachChunk([](Chunk &chunk) {
+        std::unique_lock<CountedSharedMutex> lock(chunk.getMutex());
+        chunk.deleteMeshes();
+    });
 }
 
 const TerrainGenerator &ChunkManager::getTerrainGenerator() const noexcept
@@ -69,9 +255,97 @@ const TerrainGenerator &ChunkManager::getTerrainGenerator() const noexcept
     return *m_terrainGenerator;
 }
 
+CountedSharedMutex &ChunkManager::getMapMutex() noexcept
+{
+    return m_mapMutex;
+}
+
+LockStatistics::Totals ChunkManager::takeMapLockStatistics() noexcept
+{
+    return m_mapLockStatistics.take();
+}
+
+GenerationPipeline::Statistics ChunkManager::takeGenerationStatistics()
+{
+    return m_generationPipeline->takeStatistics();
+}
+
+ColdChunkCache::Statistics ChunkManager::takeColdCacheStatistics()
+{
+    return m_coldChunks.takeStatistics();
+}
+
 void ChunkManager::unloadChunk(int x, int z)
 {
     ///@TODO Save chunk to file ?
-    if (chunkExistsAt(x, z))
-        m_chunks.erase({x, z});
+    std::unique_lock<CountedSharedMutex> lock(m_mapMutex);
+    std::vector<RetiredChunk> retired;
+    if (Chunk *chunk = m_chunks->find(x, z)) {
+        retireChunk(*chunk, retired);
+    }
+
+    m_chunks->erase(x, z);
+    m_index.erase(x, z);
+    lock.unlock();
+    destroyChunks(std::move(retired));
+}
+
+int ChunkManager::destroyRetiredMeshes(int limit)
+{
+    int count = (int)m_retiredMeshes.size();
+    if (limit > 0) {
+        count = std::min(count, limit);
+    }
+
+    m_retiredMeshes.erase(m_retiredMeshes.begin(), m_retiredMeshes.begin() + count);
+    return count;
 }
+
+int ChunkManager::getRetiredMeshCount() const noexcept
+{
+    return (int)m_retiredMeshes.size();
+}
+
+void ChunkManager::retireChunk(Chunk &chunk, std::vector<RetiredChunk> &retired)
+{
+    std::unique_lock<CountedSharedMutex> lock(chunk.getMutex());
+    bool hasLoaded = chunk.hasLoaded();
+    auto sections = chunk.releaseSections();
+    for (auto &section : sections) {
+        if (section) {
+            if (auto mesh = section->releaseMeshHandle()) {
+                m_retiredMeshes.push_back(std::move(mesh));
+            }
+        }
+    }
+
+    auto shared = std::make_shared<const ColdChunkCache::Sections>(std::move(sections));
+
+    // Cached before the map mutex is released, so the chunk is never missing
+    // from both the storage and the cache; only compressing it waits for the
+    // teardown thread. Chunks that never finished loading hold only part of
+    // their terrain
+    if (hasLoaded) {
+        m_coldChunks.storePending(chunk.getLocation(), shared);
+    }
+    retired.push_back({chunk.getLocation(), std::move(shared), hasLoaded});
+}
+
+void ChunkManager::destroyChunks(std::vector<RetiredChunk> retired)
+{
+    if (retired.empty()) {
+        return;
+    }
+
+    // ThreadPool jobs must be copyable
+    auto chunks = std::make_shared<std::vector<RetiredChunk>>(std::move(retired));
+    m_teardownWorker.push([this, chunks] {
+        for (auto &chunk : *chunks) {
+            if (chunk.isCached) {
+                m_coldChunks.compressPending(chunk.location, chunk.sections);
+            }
+        }
+        chunks->clear();
+    });
+}
+
@@ -1,43 +1,255 @@
 #ifndef CHUNKMANAGER_H_INCLUDED
 #define CHUNKMANAGER_H_INCLUDED
 
+#include <deque>
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <vector>
 
+#include "../../Config.h"
 #include "../../Maths/Vector2XZ.h"
+#include "../../Util/LockStatistics.h"
+#include "../../Util/MpscQueue.h"
+#include "../../Util/ThreadPool.h"
+#include "../Generation/GenerationPipeline.h"
 #include "../Generation/Terrain/TerrainGenerator.h"
 #include "Chunk.h"
+#include "ChunkStorage.h"
+#include "ColdChunkCache.h"
+#include "FlatChunkMap.h"
+#include "IChunkRenderer.h"
 
 class World;
 
-using ChunkMap = std::unordered_map<VectorXZ, Chunk>;
-
-/// @brief Dynamic chunk manager that affects chunk and block placement.
+/**
+ * @brief Dynamic chunk manager that affects chunk and block placement.
+ *
+ * @details
+ * The chunks are kept in a ChunkStorage picked from the config: a hash map by
+ * default, or a fixed ring buffer around the player when "ringchunkstorage"
+ * is enabled. Either way, chunks are loaded within the load distance of the
+ * centre set with setCentre, and only unloaded once they are further than
+ * the unload distance, a few chunks beyond it. The load distance is one
+ * chunk past the render distance, as a chunk is only meshed once its eight
+ * neighbours have loaded.
+ *
+ * Chunks requested with requestChunk are generated in the background by a
+ * GenerationPipeline, and loaded into the storage by loadGeneratedChunks.
+ * Chunks that unloaded recently are kept compressed in a ColdChunkCache and
+ * loaded from there instead, edits and all.
+ *
+ * The storage is guarded by the map mutex, held exclusively to add or remove
+ * chunks. Chunks are only removed by setCentre and unloadChunk, which are
+ * called from the main thread, so the main thread can use the chunks it
+ * finds right away; any other thread holds the map mutex shared while it
+ * looks chunks up with findStoredChunk and uses them.
+ *
+ * The main thread looks chunks up in an index of its own instead, without
+ * any locking or atomics. Chunks it adds or removes are put in or taken out
+ * of the index straight away. Chunks loaded by the chunk loader are only
+ * queued, and added by updateIndex once per frame.
+ *
+ * Unloading a chunk hands its sections to the cache right away, so a
+ * request for it straight after finds it there. They are compressed and
+ * destroyed on a background thread, and the GPU buffers of their meshes are
+ * kept for destroyRetiredMeshes to free a few at a time, so leaving many
+ * chunks behind at once does not stall the frame.
+ */
 class ChunkManager {
   public:
-    ChunkManager(World &world);
+    ChunkManager(World &world, const Config &config);
 
+    /**
+     * @brief Gets the chunk at the given position, creating it if needed.
+     *
+     * @details
+     * If the storage cannot hold a chunk at the position, an empty chunk which
+     * reads as air is returned instead.
+     */
     Chunk &getChunk(int x, int z);
-    ChunkMap &getChunks();
 
-    bool makeMesh(int x, int z, const Camera &camera);
+    /// @brief Gets the chunk at the given position, creating it if needed.
+    /// @return The chunk, or nullptr if the storage cannot hold it.
+    Chunk *tryGetChunk(int x, int z);
+
+    /// @brief Gets the chunk at the given position if it is in the index,
+    /// without locking. Only for the main thread.
+    const Chunk *findChunk(int x, int z) const noexcept;
+    Chunk *findChunk(int x, int z) noexcept;
+
+    /// @brief Gets the chunk at the given position if it exists, for any
+    /// thread other than the main one, which must hold the map mutex shared.
+    Chunk *findStoredChunk(int x, int z) noexcept;
+
+    /// @brief Calls the function with every chunk in the index, without
+    /// locking. Only for the main thread.
+    void forEachChunk(const std::function<void(Chunk &)> &function);
+
+    /// @brief Moves the centre of the loaded area, dropping the chunks
+    /// further than the unload distance. Called every frame by the main
+    /// thread.
+    void setCentre(int x, int z);
+
+    /**
+     * @brief Adds the chunks loaded by other threads since the last call to
+     * the index.
+     *
+     * @details
+     * Called once per frame by the main thread. A chunk is queued before
+     * any mesh of it can be built, so calling this after taking the built
+     * meshes finds the chunk of every one of them.
+     */
+    void updateIndex();
+
+    /**
+     * @brief Reorders the chunks waiting to be generated around the camera.
+     *
+     * @details
+     * Chunks waiting beyond the load distance, past the neighbours the
+     * chunks at its edge need, are dropped.
+     */
+    void setFocus(const glm::vec3 &position, const ViewFrustum &frustum);
+
+    /// @brief Gets how far from the centre chunks are requested, the render
+    /// distance and the ring of neighbours its edge is meshed with.
+    int getLoadDistance() const noexcept;
 
+    /**
+     * @brief Queues meshes for the sections of the chunk at the given
+     * position that have none.
+     *
+     * @return The number of meshes queued, which is always 0 before the
+     *         chunk and its eight neighbours have loaded.
+     *
+     * @details
+     * Holds the map mutex shared, and locks the chunk and its neighbours
+     * with a ChunkAreaLock while the sections are captured. Must not be
+     * called with the map mutex held.
+     */
+    int makeMeshes(int x, int z);
+
+    /// @brief Checks the index for a loaded chunk. Only for the main thread.
     bool chunkLoadedAt(int x, int z) const;
     bool chunkExistsAt(int x, int z) const;
 
     void loadChunk(int x, int z);
     void unloadChunk(int x, int z);
 
+    /// @brief Asks for the chunk at the given position to be loaded from
+    /// the cache, or generated in the background if it is not cached.
+    /// Does nothing if the chunk has loaded. Must not be called with the
+    /// map mutex held.
+    void requestChunk(int x, int z);
+
+    /**
+     * @brief Loads the chunks the generation pipeline has finished, and
+     * those taken from the cache.
+     *
+     * @details
+     * Chunks which have loaded in the meantime, or which the storage cannot
+     * hold any more, are dropped. A chunk taken from the cache is loaded
+     * in place of one generated at the same time, so edits are never
+     * replaced by fresh terrain.
+     *
+     * @return The positions of the chunks that were loaded.
+     */
+    std::vector<sf::Vector2i> loadGeneratedChunks();
+
     void deleteMeshes();
 
+    /**
+     * @brief Frees the GPU buffers of meshes whose chunks have unloaded.
+     *
+     * @param limit The most buffers to free, or 0 to free all of them.
+     * @return The number of buffers freed.
+     *
+     * @details
+     * Must be called on the GL thread.
+     */
+    int destroyRetiredMeshes(int limit);
+
+    /// @brief Gets the number of buffers waiting for destroyRetiredMeshes.
+    int getRetiredMeshCount() const noexcept;
+
     const TerrainGenerator &getTerrainGenerator() const noexcept;
 
+    /**
+     * @brief Gets the mutex guarding which chunks are stored.
+     *
+     * @details
+     * Threads other than the main thread hold it shared while they use the
+     * chunks they find, so none of them is unloaded in the meantime.
+     */
+    CountedSharedMutex &getMapMutex() noexcept;
+
+    /// @brief Returns the statistics of the map mutex since the last call,
+    /// and resets them.
+    LockStatistics::Totals takeMapLockStatistics() noexcept;
+
+    /// @brief Returns the statistics of the generation pipeline since the
+    /// last call, and resets them.
+    GenerationPipeline::Statistics takeGenerationStatistics();
+
+    /// @brief Returns the statistics of the cache of unloaded chunks since
+    /// the last call, and resets them.
+    ColdChunkCache::Statistics takeColdCacheStatistics();
+
   private:
-    ChunkMap m_chunks;
+    // Checks the storage for a loaded chunk; called with the map mutex held
+    bool storedChunkLoadedAt(int x, int z);
+
+    // The sections of a chunk that is being unloaded, shared with the cache
+    // until they are compressed
+    struct RetiredChunk {
+        sf::Vector2i location;
+        std::shared_ptr<const ColdChunkCache::Sections> sections;
+        bool isCached;
+    };
+
+    // Takes the sections out of a chunk about to be removed and hands them
+    // to the cache, keeping their buffered meshes for the GL thread; called
+    // with the map mutex held exclusively
+    void retireChunk(Chunk &chunk, std::vector<RetiredChunk> &retired);
+
+    // Compresses and destroys retired chunks on the teardown thread
+    void destroyChunks(std::vector<RetiredChunk> retired);
+
+    std::unique_ptr<ChunkStorage> m_chunks;
+
+    // Only used on the main thread
+    FlatChunkMap<Chunk *> m_index;
+
+    // Loaded by the chunk loader, waiting for updateIndex
+    MpscQueue<sf::Vector2i> m_loadedChunks;
+
+    LockStatistics m_mapLockStatistics;
+    CountedSharedMutex m_mapMutex{m_mapLockStatistics};
+
     std::unique_ptr<TerrainGenerator> m_terrainGenerator;
+    std::unique_ptr<GenerationPipeline> m_generationPipeline;
 
     World *m_world;
+    Chunk m_outOfRangeChunk;
+    int m_loadDistance;
+    int m_unloadDistance;
+
+    // Only used by setCentre, on the main thread
+    int m_centreX = 0;
+    int m_centreZ = 0;
+    bool m_hasCentre = false;
+
+    // Only used on the main thread
+    std::deque<std::unique_ptr<IChunkMeshHandle>> m_retiredMeshes;
+
+    ColdChunkCache m_coldChunks;
+
+    // Taken from the cache by requestChunk, for loadGeneratedChunks
+    std::mutex m_restoredMutex;
+    std::vector<std::unique_ptr<Chunk>> m_restoredChunks;
+
+    // Declared last, as its jobs use the cache
+    ThreadPool m_teardownWorker{1};
 };
 
 #endif // CHUNKMANAGER_H_INCLUDED
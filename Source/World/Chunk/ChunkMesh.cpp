@@ -4,63 +4,89 @@
 
 #include <iostream>
 
-void ChunkMesh::addFace(const std::array<GLfloat, 12> &blockFace,
-                        const std::array<GLfloat, 8> &textureCoords,
-                        const sf::Vector3i &chunkPosition,
+namespace {
+// Bit offsets of the packed vertex fields, see ChunkMesh
+constexpr int POSITION_BITS = 5;
+constexpr int TEXTURE_U_SHIFT = 3 * POSITION_BITS;
+constexpr int TEXTURE_V_SHIFT = 4 * POSITION_BITS;
+constexpr int TILE_ROW_SHIFT = 8;
+constexpr int LIGHT_SHIFT = 16;
+} // namespace
+
+void ChunkMesh::addFace(const std::array<float, 12> &blockFace,
+                        const sf::Vector2i &textureTile,
                         const sf::Vector3i &blockPosition,
-                        GLfloat cardinalLight)
+                        float cardinalLight, const sf::Vector3i &size)
 {
     faces++;
-    auto &verticies = m_mesh.vertexPositions;
-    auto &texCoords = m_mesh.textureCoords;
-    auto &indices = m_mesh.indices;
 
-    texCoords.insert(texCoords.end(), textureCoords.begin(),
-                     textureCoords.end());
+    // The texture runs along the edge from corner 0 to 1 and from 1 to 2, so
+    // those edges decide how often the tile repeats in each direction
+    auto edgeLength = [&](int from, int to) {
+        const int sizes[3] = {size.x, size.y, size.z};
+        for (int axis = 0; axis < 3; axis++) {
+            if (blockFace[from * 3 + axis] != blockFace[to * 3 + axis]) {
+                return (uint32_t)sizes[axis];
+            }
+        }
+        return 1u;
+    };
+    uint32_t width = edgeLength(0, 1);
+    uint32_t height = edgeLength(1, 2);
+    const uint32_t texCoords[8] = {width, height, 0, height, 0, 0, width, 0};
+
+    uint32_t tileAndLight = (uint32_t)textureTile.x |
+                            (uint32_t)textureTile.y << TILE_ROW_SHIFT |
+                            (uint32_t)(cardinalLight * 255 + 0.5f) << LIGHT_SHIFT;
 
     /// Vertex: The current vertex in the "blockFace" vector, 4 vertex in total
     /// hence "< 4" Index: X, Y, Z
     for (int i = 0, index = 0; i < 4; ++i) {
-        verticies.push_back(blockFace[index++] + chunkPosition.x * CHUNK_SIZE +
-                            blockPosition.x);
-        verticies.push_back(blockFace[index++] + chunkPosition.y * CHUNK_SIZE +
-                            blockPosition.y);
-        verticies.push_back(blockFace[index++] + chunkPosition.z * CHUNK_SIZE +
-                            blockPosition.z);
-        m_light.push_back(cardinalLight);
+        uint32_t x = (uint32_t)blockFace[index++] * size.x + blockPosition.x;
+        uint32_t y = (uint32_t)blockFace[index++] * size.y + blockPosition.y;
+        uint32_t z = (uint32_t)blockFace[index++] * size.z + blockPosition.z;
+
+        m_vertices.push_back(x | y << POSITION_BITS | z << 2 * POSITION_BITS |
+                             texCoords[i * 2] << TEXTURE_U_SHIFT |
+                             texCoords[i * 2 + 1] << TEXTURE_V_SHIFT);
+        m_vertices.push_back(tileAndLight);
     }
 
-    indices.insert(indices.end(),
-                   {m_indexIndex, m_indexIndex + 1, m_indexIndex + 2,
+    m_indices.insert(m_indices.end(),
+                     {m_indexIndex, m_indexIndex + 1, m_indexIndex + 2,
 
-                    m_indexIndex + 2, m_indexIndex + 3, m_indexIndex});
+                      m_indexIndex + 2, m_indexIndex + 3, m_indexIndex});
     m_indexIndex += 4;
 }
 
-void ChunkMesh::bufferMesh()
+const std::vector<uint32_t> &ChunkMesh::getVertices() const
+{
+    return m_vertices;
+}
+
+const std::vector<uint32_t> &ChunkMesh::getIndices() const
 {
-    m_model.addData(m_mesh);
-    m_model.addVBO(1, m_light);
+    return m_indices;
+}
 
-    m_mesh.vertexPositions.clear();
-    m_mesh.textureCoords.clear();
-    m_mesh.indices.clear();
-    m_light.clear();
+void ChunkMesh::clearData()
+{
+    m_vertices.clear();
+    m_indices.clear();
 
-    m_mesh.vertexPositions.shrink_to_fit();
-    m_mesh.textureCoords.shrink_to_fit();
-    m_mesh.indices.shrink_to_fit();
-    m_light.shrink_to_fit();
+    m_vertices.shrink_to_fit();
+    m_indices.shrink_to_fit();
 
     m_indexIndex = 0;
 }
 
-void ChunkMesh::deleteData()
+void ChunkMesh::setLocation(const sf::Vector3i &location)
 {
-    m_model.deleteData();
+    m_location = location;
 }
 
-const Model &ChunkMesh::getModel() const
+sf::Vector3f ChunkMesh::getWorldPosition() const
 {
-    return m_model;
+    return {(float)(m_location.x * CHUNK_SIZE), (float)(m_location.y * CHUNK_SIZE),
+            (float)(m_location.z * CHUNK_SIZE)};
 }
@@ -1,34 +1,74 @@
 #ifndef CHUNKMESH_H_INCLUDED
 #define CHUNKMESH_H_INCLUDED
 
-#include "../../Model.h"
-
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
 #include <array>
+#include <cstdint>
 #include <vector>
 
+/**
+ * @class ChunkMesh
+ * @brief The faces of one chunk section drawn with the same shader.
+ *
+ * @details
+ * Vertices are packed into two 32 bit words. The first holds the corner's
+ * position inside the section (5 bits per axis, 0 to CHUNK_SIZE inclusive)
+ * followed by its texture coordinate in tiles (5 bits each). The second holds
+ * the atlas column and row of the tile and the light, 8 bits each. Positions
+ * are relative to the section; the renderers pass its world position to the
+ * shaders as a uniform per draw.
+ *
+ * The mesh only holds the vertex data. The renderer copies it into GPU
+ * buffers of its own through IChunkRenderer::bufferMesh, after which the
+ * data here can be freed.
+ */
 class ChunkMesh {
   public:
+    /// @brief GPU memory used by one face: four vertices and six indices.
+    static constexpr int BYTES_PER_FACE =
+        4 * 2 * sizeof(uint32_t) + 6 * sizeof(uint32_t);
+
     ChunkMesh() = default;
 
-    void addFace(const std::array<GLfloat, 12> &blockFace,
-                 const std::array<GLfloat, 8> &textureCoords,
-                 const sf::Vector3i &chunkPosition,
-                 const sf::Vector3i &blockPosition, GLfloat cardinalLight);
+    /**
+     * @brief Adds a face to the mesh.
+     *
+     * @param blockFace     The corners of the face on a unit cube.
+     * @param textureTile   The column and row of the tile in the atlas.
+     * @param blockPosition The block the face belongs to; for a merged face,
+     *                      the block at its lowest corner.
+     * @param cardinalLight The brightness of the face.
+     * @param size          The number of blocks the face spans on each axis.
+     *
+     * @details
+     * A face spanning several blocks repeats its texture once per block.
+     */
+    void addFace(const std::array<float, 12> &blockFace,
+                 const sf::Vector2i &textureTile,
+                 const sf::Vector3i &blockPosition, float cardinalLight,
+                 const sf::Vector3i &size = {1, 1, 1});
+
+    /// @brief Gets the packed vertices, two words each.
+    const std::vector<uint32_t> &getVertices() const;
+    const std::vector<uint32_t> &getIndices() const;
 
-    void bufferMesh();
+    /// @brief Frees the vertex data, keeping the face count and location.
+    void clearData();
 
-    const Model &getModel() const;
+    /// @brief Sets the location of the section the mesh belongs to.
+    void setLocation(const sf::Vector3i &location);
 
-    void deleteData();
+    /// @brief Gets the world position of the section, which vertices are relative to.
+    sf::Vector3f getWorldPosition() const;
 
     int faces = 0;
 
   private:
-    Mesh m_mesh;
-    Model m_model;
-    std::vector<GLfloat> m_light;
-    GLuint m_indexIndex = 0;
+    std::vector<uint32_t> m_vertices;
+    std::vector<uint32_t> m_indices;
+    sf::Vector3i m_location;
+    uint32_t m_indexIndex = 0;
 };
 
 struct ChunkMeshCollection {
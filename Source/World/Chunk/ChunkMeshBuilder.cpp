@@ -2,56 +2,86 @@
 
 #include "ChunkMesh.h"
 #include "ChunkSection.h"
+#include "GreedyMeshing.h"
+#include "SectionColumns.h"
+#include "SectionSnapshot.h"
 
+#include "../../Config.h"
 #include "../Block/BlockData.h"
-#include "../Block/BlockDatabase.h"
 
 #include <SFML/System/Clock.hpp>
+#include <bit>
 #include <cassert>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 namespace {
-const std::array<GLfloat, 12> frontFace{
+const std::array<float, 12> frontFace{
     0, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1,
 };
 
-const std::array<GLfloat, 12> backFace{
+const std::array<float, 12> backFace{
     1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0,
 };
 
-const std::array<GLfloat, 12> leftFace{
+const std::array<float, 12> leftFace{
     0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0,
 };
 
-const std::array<GLfloat, 12> rightFace{
+const std::array<float, 12> rightFace{
     1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1,
 };
 
-const std::array<GLfloat, 12> topFace{
+const std::array<float, 12> topFace{
     0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 0,
 };
 
-const std::array<GLfloat, 12> bottomFace{0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1};
+const std::array<float, 12> bottomFace{0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1};
 
-const std::array<GLfloat, 12> xFace1{
+const std::array<float, 12> xFace1{
     0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 1, 0,
 };
 
-const std::array<GLfloat, 12> xFace2{
+const std::array<float, 12> xFace2{
     0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1,
 };
 
-constexpr GLfloat LIGHT_TOP = 1.0f;
-constexpr GLfloat LIGHT_X = 0.8f;
-constexpr GLfloat LIGHT_Z = 0.6f;
-constexpr GLfloat LIGHT_BOT = 0.4f;
+constexpr float LIGHT_TOP = 1.0f;
+constexpr float LIGHT_X = 0.8f;
+constexpr float LIGHT_Z = 0.6f;
+constexpr float LIGHT_BOT = 0.4f;
+
+// How each of the six cube faces is laid out: the axis the face points along,
+// the two axes spanning its slices, and its texture. Ordered like
+// ChunkSection::Neighbour.
+struct FaceLayout {
+    const std::array<float, 12> &face;
+    int normalAxis;
+    int normalOffset;
+    int uAxis;
+    int vAxis;
+    sf::Vector2i BlockDataHolder::*texture;
+    float light;
+};
+
+const std::array<FaceLayout, 6> faceLayouts{{
+    {leftFace, 0, -1, 1, 2, &BlockDataHolder::texSideCoord, LIGHT_X},
+    {rightFace, 0, 1, 1, 2, &BlockDataHolder::texSideCoord, LIGHT_X},
+    {bottomFace, 1, -1, 0, 2, &BlockDataHolder::texBottomCoord, LIGHT_BOT},
+    {topFace, 1, 1, 0, 2, &BlockDataHolder::texTopCoord, LIGHT_TOP},
+    {backFace, 2, -1, 0, 1, &BlockDataHolder::texSideCoord, LIGHT_Z},
+    {frontFace, 2, 1, 0, 1, &BlockDataHolder::texSideCoord, LIGHT_Z},
+}};
+
+std::mutex statisticsMutex;
+ChunkMeshBuilder::Statistics statistics;
 
 } // namespace
 
-ChunkMeshBuilder::ChunkMeshBuilder(ChunkSection &chunk,
+ChunkMeshBuilder::ChunkMeshBuilder(const SectionSnapshot &snapshot,
                                    ChunkMeshCollection &mesh)
-    : m_pChunk(&chunk)
+    : m_pSnapshot(&snapshot)
     , m_pMeshes(&mesh)
 {
 }
@@ -75,60 +105,336 @@ struct AdjacentBlockPositions {
     sf::Vector3i back;
 };
 
-int faces;
-void ChunkMeshBuilder::buildMesh()
+ChunkMeshBuilder::Statistics ChunkMeshBuilder::takeStatistics()
+{
+    std::unique_lock<std::mutex> lock(statisticsMutex);
+    Statistics taken = statistics;
+    statistics = {};
+    return taken;
+}
+
+ChunkMeshBuilder::Mode ChunkMeshBuilder::getMode(const Config &config)
+{
+    return config.greedyMeshing   ? Mode::Greedy
+           : config.columnMeshing ? Mode::Columns
+                                  : Mode::PerFace;
+}
+
+void ChunkMeshBuilder::buildMesh(Mode mode)
 {
-    AdjacentBlockPositions directions;
-    m_pBlockPtr = m_pChunk->begin();
-    faces = 0;
     sf::Clock timer;
-    for (int16_t i = 0; i < CHUNK_VOLUME; i++) {
-        uint8_t x = i % CHUNK_SIZE;
-        uint8_t y = i / (CHUNK_SIZE * CHUNK_SIZE);
-        uint8_t z = (i / CHUNK_SIZE) % CHUNK_SIZE;
+    int facesBefore = m_pMeshes->solidMesh.faces + m_pMeshes->waterMesh.faces +
+                      m_pMeshes->floraMesh.faces;
 
-        if (!shouldMakeLayer(y)) {
-            continue;
-        }
+    // Vertices are stored relative to the section
+    m_pMeshes->solidMesh.setLocation(m_pSnapshot->getLocation());
+    m_pMeshes->waterMesh.setLocation(m_pSnapshot->getLocation());
+    m_pMeshes->floraMesh.setLocation(m_pSnapshot->getLocation());
 
-        ChunkBlock block = *m_pBlockPtr;
-        m_pBlockPtr++;
+    if (m_pSnapshot->isUniform() &&
+        m_pSnapshot->getUniformBlock() == BlockId::Air) {
+        return;
+    }
+    else if (mode == Mode::Greedy) {
+        buildGreedyMesh();
+    }
+    else if (mode == Mode::Columns) {
+        buildColumnMesh();
+    }
+    else if (m_pSnapshot->isUniform() &&
+             m_pSnapshot->getUniformBlock().getData().isOpaque &&
+             m_pSnapshot->getUniformBlock().getData().meshType ==
+                 BlockMeshType::Cube) {
+        buildUniformMesh(m_pSnapshot->getUniformBlock());
+    }
+    else {
+        buildBlockMesh();
+    }
+
+    int facesAfter = m_pMeshes->solidMesh.faces + m_pMeshes->waterMesh.faces +
+                     m_pMeshes->floraMesh.faces;
 
-        sf::Vector3i position(x, y, z);
-        setActiveMesh(block);
+    std::unique_lock<std::mutex> lock(statisticsMutex);
+    statistics.sections++;
+    statistics.faces += facesAfter - facesBefore;
+    statistics.buildSeconds += timer.getElapsedTime().asSeconds();
+}
+
+void ChunkMeshBuilder::buildBlockMesh()
+{
+    AdjacentBlockPositions directions;
 
-        if (block == BlockId::Air) {
+    // Only visit non-air blocks, skipping 64 empty blocks at a time
+    auto &nonAirMask = m_pSnapshot->getNonAirMask();
+    for (int w = 0; w < ChunkSection::BlockMask::NUM_WORDS; w++) {
+        uint64_t word = nonAirMask.getWord(w);
+        if (word == 0 || !shouldMakeLayer(w * 64 / CHUNK_AREA)) {
             continue;
         }
 
-        m_pBlockData = &block.getData();
-        auto &data = *m_pBlockData;
+        for (; word != 0; word &= word - 1) {
+            int i = w * 64 + std::countr_zero(word);
+            uint8_t x = i % CHUNK_SIZE;
+            uint8_t y = i / (CHUNK_SIZE * CHUNK_SIZE);
+            uint8_t z = (i / CHUNK_SIZE) % CHUNK_SIZE;
+
+            ChunkBlock block = m_pSnapshot->getBlock(x, y, z);
+
+            sf::Vector3i position(x, y, z);
+            setActiveMesh(block);
+
+            m_pBlockData = &block.getData();
+            auto &data = *m_pBlockData;
+
+            if (data.meshType == BlockMeshType::X) {
+                addXBlockToMesh(data.texTopCoord, position);
+                continue;
+            }
+
+            directions.update(x, y, z);
+
+            // Up/ Down
+            if ((m_pSnapshot->getLocation().y != 0) || y != 0)
+                tryAddFaceToMesh(bottomFace, data.texBottomCoord, position,
+                                 directions.down, LIGHT_BOT);
+            tryAddFaceToMesh(topFace, data.texTopCoord, position,
+                             directions.up, LIGHT_TOP);
+
+            // Left/ Right
+            tryAddFaceToMesh(leftFace, data.texSideCoord, position,
+                             directions.left, LIGHT_X);
+            tryAddFaceToMesh(rightFace, data.texSideCoord, position,
+                             directions.right, LIGHT_X);
+
+            // Front/ Back
+            tryAddFaceToMesh(frontFace, data.texSideCoord, position,
+                             directions.front, LIGHT_Z);
+            tryAddFaceToMesh(backFace, data.texSideCoord, position,
+                             directions.back, LIGHT_Z);
+        }
+    }
+}
+
+// A section made of one opaque block can only have faces on its outside, so
+// only the outward face of each of the six boundary planes needs checking
+void ChunkMeshBuilder::buildUniformMesh(ChunkBlock block)
+{
+    setActiveMesh(block);
+    m_pBlockData = &block.getData();
+    auto &data = *m_pBlockData;
+
+    // A plane facing a fully opaque neighbouring face is hidden as a whole
+    auto isVisible = [&](ChunkSection::Neighbour face) {
+        return !m_pSnapshot->getOpaqueFace(face).all();
+    };
 
-        if (data.meshType == BlockMeshType::X) {
-            addXBlockToMesh(data.texTopCoord, position);
-            continue;
+    constexpr int MAX = CHUNK_SIZE - 1;
+    bool isLowestSection = m_pSnapshot->getLocation().y == 0;
+
+    bool top = isVisible(ChunkSection::PosY);
+    bool bottom = !isLowestSection && isVisible(ChunkSection::NegY);
+    bool left = isVisible(ChunkSection::NegX);
+    bool right = isVisible(ChunkSection::PosX);
+    bool front = isVisible(ChunkSection::PosZ);
+    bool back = isVisible(ChunkSection::NegZ);
+
+    for (int a = 0; a < CHUNK_SIZE; a++)
+        for (int b = 0; b < CHUNK_SIZE; b++) {
+            // Up/ Down
+            if (top)
+                tryAddFaceToMesh(topFace, data.texTopCoord, {a, MAX, b},
+                                 {a, CHUNK_SIZE, b}, LIGHT_TOP);
+            if (bottom)
+                tryAddFaceToMesh(bottomFace, data.texBottomCoord, {a, 0, b},
+                                 {a, -1, b}, LIGHT_BOT);
+
+            // Left/ Right
+            if (left)
+                tryAddFaceToMesh(leftFace, data.texSideCoord, {0, a, b},
+                                 {-1, a, b}, LIGHT_X);
+            if (right)
+                tryAddFaceToMesh(rightFace, data.texSideCoord, {MAX, a, b},
+                                 {CHUNK_SIZE, a, b}, LIGHT_X);
+
+            // Front/ Back
+            if (front)
+                tryAddFaceToMesh(frontFace, data.texSideCoord, {a, b, MAX},
+                                 {a, b, CHUNK_SIZE}, LIGHT_Z);
+            if (back)
+                tryAddFaceToMesh(backFace, data.texSideCoord, {a, b, 0},
+                                 {a, b, -1}, LIGHT_Z);
         }
+}
+
+// Merges neighbouring faces of the same block type and direction into one
+// quad; only X shaped blocks are still added one by one
+void ChunkMeshBuilder::buildGreedyMesh()
+{
+    auto &nonAirMask = m_pSnapshot->getNonAirMask();
+    bool isLowestSection = m_pSnapshot->getLocation().y == 0;
+
+    for (int w = 0; w < ChunkSection::BlockMask::NUM_WORDS; w++) {
+        for (uint64_t word = nonAirMask.getWord(w); word != 0;
+             word &= word - 1) {
+            int i = w * 64 + std::countr_zero(word);
+            int x = i % CHUNK_SIZE;
+            int y = i / CHUNK_AREA;
+            int z = (i / CHUNK_SIZE) % CHUNK_SIZE;
+
+            ChunkBlock block = m_pSnapshot->getBlock(x, y, z);
+            auto &data = block.getData();
+            if (data.meshType == BlockMeshType::X) {
+                setActiveMesh(block);
+                addXBlockToMesh(data.texTopCoord, {x, y, z});
+            }
+        }
+    }
 
-        directions.update(x, y, z);
+    FaceSlice slice;
+    for (auto &layout : faceLayouts) {
+        for (int d = 0; d < CHUNK_SIZE; d++) {
+            if (isLowestSection && d == 0 && layout.normalAxis == 1 &&
+                layout.normalOffset < 0) {
+                continue;
+            }
+
+            bool hasFaces = false;
+            for (int v = 0; v < CHUNK_SIZE; v++) {
+                for (int u = 0; u < CHUNK_SIZE; u++) {
+                    int position[3];
+                    position[layout.normalAxis] = d;
+                    position[layout.uAxis] = u;
+                    position[layout.vAxis] = v;
+
+                    uint16_t &key = slice[v * CHUNK_SIZE + u];
+                    key = 0;
+
+                    int index = ChunkSection::getIndex(position[0], position[1],
+                                                       position[2]);
+                    if (!nonAirMask.test(index)) {
+                        continue;
+                    }
+
+                    ChunkBlock block = m_pSnapshot->getBlock(
+                        position[0], position[1], position[2]);
+                    m_pBlockData = &block.getData();
+                    if (m_pBlockData->meshType == BlockMeshType::X) {
+                        continue;
+                    }
+
+                    position[layout.normalAxis] += layout.normalOffset;
+                    if (shouldMakeFace({position[0], position[1], position[2]},
+                                       *m_pBlockData)) {
+                        key = block.id;
+                        hasFaces = true;
+                    }
+                }
+            }
+
+            if (!hasFaces) {
+                continue;
+            }
+
+            mergeFaces(slice, [&](uint16_t key, int u, int v, int width,
+                                  int height) {
+                ChunkBlock block(static_cast<Block_t>(key));
+                setActiveMesh(block);
+
+                int position[3];
+                position[layout.normalAxis] = d;
+                position[layout.uAxis] = u;
+                position[layout.vAxis] = v;
+
+                int size[3];
+                size[layout.normalAxis] = 1;
+                size[layout.uAxis] = width;
+                size[layout.vAxis] = height;
+
+                m_pActiveMesh->addFace(
+                    layout.face, block.getData().*layout.texture,
+                    {position[0], position[1], position[2]}, layout.light,
+                    {size[0], size[1], size[2]});
+            });
+        }
+    }
+}
 
-        // Up/ Down
-        if ((m_pChunk->getLocation().y != 0) || y != 0)
-            tryAddFaceToMesh(bottomFace, data.texBottomCoord, position,
-                             directions.down, LIGHT_BOT);
-        tryAddFaceToMesh(topFace, data.texTopCoord, position, directions.up,
-                         LIGHT_TOP);
+// Finds every visible face with bit operations on the section's columns, and
+// only reads blocks where a face is actually made
+void ChunkMeshBuilder::buildColumnMesh()
+{
+    SectionColumns::FaceMasks opaqueFaces;
+    SectionColumns::FaceMasks nonAirFaces;
+    for (int i = 0; i < ChunkSection::NUM_NEIGHBOURS; i++) {
+        opaqueFaces[i] = &m_pSnapshot->getOpaqueFace(i);
+        nonAirFaces[i] = &m_pSnapshot->getNonAirFace(i);
+    }
 
-        // Left/ Right
-        tryAddFaceToMesh(leftFace, data.texSideCoord, position, directions.left,
-                         LIGHT_X);
-        tryAddFaceToMesh(rightFace, data.texSideCoord, position,
-                         directions.right, LIGHT_X);
+    SectionColumns columns;
+    columns.build(m_pSnapshot->getOpaqueMask(), m_pSnapshot->getNonAirMask(),
+                  opaqueFaces, nonAirFaces);
+
+    // X shaped blocks are never opaque
+    auto &opaqueMask = m_pSnapshot->getOpaqueMask();
+    auto &nonAirMask = m_pSnapshot->getNonAirMask();
+    for (int w = 0; w < ChunkSection::BlockMask::NUM_WORDS; w++) {
+        uint64_t word = nonAirMask.getWord(w) & ~opaqueMask.getWord(w);
+        for (; word != 0; word &= word - 1) {
+            int i = w * 64 + std::countr_zero(word);
+            int x = i % CHUNK_SIZE;
+            int y = i / CHUNK_AREA;
+            int z = (i / CHUNK_SIZE) % CHUNK_SIZE;
+
+            ChunkBlock block = m_pSnapshot->getBlock(x, y, z);
+            auto &data = block.getData();
+            if (data.meshType == BlockMeshType::X) {
+                setActiveMesh(block);
+                addXBlockToMesh(data.texTopCoord, {x, y, z});
+            }
+        }
+    }
 
-        // Front/ Back
-        tryAddFaceToMesh(frontFace, data.texSideCoord, position,
-                         directions.front, LIGHT_Z);
-        tryAddFaceToMesh(backFace, data.texSideCoord, position, directions.back,
-                         LIGHT_Z);
+    bool isLowestSection = m_pSnapshot->getLocation().y == 0;
+
+    for (int d = 0; d < ChunkSection::NUM_NEIGHBOURS; d++) {
+        auto direction = static_cast<SectionColumns::Direction>(d);
+        auto &layout = faceLayouts[d];
+
+        for (int column = 0; column < CHUNK_AREA; column++) {
+            auto faces = columns.getFaces(direction, column);
+            uint32_t visible = faces.open | faces.transparent;
+            if (isLowestSection && direction == SectionColumns::NegY) {
+                visible &= ~1u;
+            }
+
+            for (; visible != 0; visible &= visible - 1) {
+                int i = std::countr_zero(visible);
+                int position[3];
+                SectionColumns::getPosition(direction, column, i, position[0],
+                                            position[1], position[2]);
+
+                ChunkBlock block =
+                    m_pSnapshot->getBlock(position[0], position[1], position[2]);
+                m_pBlockData = &block.getData();
+                if (m_pBlockData->meshType == BlockMeshType::X) {
+                    continue;
+                }
+
+                sf::Vector3i blockPosition(position[0], position[1],
+                                           position[2]);
+                position[layout.normalAxis] += layout.normalOffset;
+                if (((faces.transparent >> i) & 1) &&
+                    !shouldMakeFace({position[0], position[1], position[2]},
+                                    *m_pBlockData)) {
+                    continue;
+                }
+
+                setActiveMesh(block);
+                m_pActiveMesh->addFace(layout.face,
+                                       m_pBlockData->*layout.texture,
+                                       blockPosition, layout.light);
+            }
+        }
     }
 }
 
@@ -152,36 +458,33 @@ void ChunkMeshBuilder::setActiveMesh(ChunkBlock block)
 void ChunkMeshBuilder::addXBlockToMesh(const sf::Vector2i &textureCoords,
                                        const sf::Vector3i &blockPosition)
 {
-    faces++;
-    auto texCoords =
-        BlockDatabase::get().textureAtlas.getTexture(textureCoords);
-
-    m_pActiveMesh->addFace(xFace1, texCoords, m_pChunk->getLocation(),
-                           blockPosition, LIGHT_X);
-
-    m_pActiveMesh->addFace(xFace2, texCoords, m_pChunk->getLocation(),
-                           blockPosition, LIGHT_X);
+    m_pActiveMesh->addFace(xFace1, textureCoords, blockPosition, LIGHT_X);
+    m_pActiveMesh->addFace(xFace2, textureCoords, blockPosition, LIGHT_X);
 }
 
 void ChunkMeshBuilder::tryAddFaceToMesh(
-    const std::array<GLfloat, 12> &blockFace, const sf::Vector2i &textureCoords,
+    const std::array<float, 12> &blockFace, const sf::Vector2i &textureCoords,
     const sf::Vector3i &blockPosition, const sf::Vector3i &blockFacing,
-    GLfloat cardinalLight)
+    float cardinalLight)
 {
     if (shouldMakeFace(blockFacing, *m_pBlockData)) {
-        faces++;
-        auto texCoords =
-            BlockDatabase::get().textureAtlas.getTexture(textureCoords);
-
-        m_pActiveMesh->addFace(blockFace, texCoords, m_pChunk->getLocation(),
-                               blockPosition, cardinalLight);
+        m_pActiveMesh->addFace(blockFace, textureCoords, blockPosition,
+                               cardinalLight);
     }
 }
 
 bool ChunkMeshBuilder::shouldMakeFace(const sf::Vector3i &adjBlock,
                                       const BlockDataHolder &blockData)
 {
-    auto block = m_pChunk->getBlock(adjBlock.x, adjBlock.y, adjBlock.z);
+    // An opaque block inside the section hides the face without a lookup
+    if (adjBlock.x >= 0 && adjBlock.x < CHUNK_SIZE && adjBlock.y >= 0 &&
+        adjBlock.y < CHUNK_SIZE && adjBlock.z >= 0 && adjBlock.z < CHUNK_SIZE &&
+        m_pSnapshot->getOpaqueMask().test(
+            ChunkSection::getIndex(adjBlock.x, adjBlock.y, adjBlock.z))) {
+        return false;
+    }
+
+    auto block = m_pSnapshot->getBlock(adjBlock.x, adjBlock.y, adjBlock.z);
     auto &data = block.getData();
 
     if (block == BlockId::Air) {
@@ -195,15 +498,20 @@ bool ChunkMeshBuilder::shouldMakeFace(const sf::Vector3i &adjBlock,
 
 bool ChunkMeshBuilder::shouldMakeLayer(int y)
 {
-    auto adjIsSolid = [&](int dx, int dz) {
-        const ChunkSection &sect = m_pChunk->getAdjacent(dx, dz);
-        return sect.getLayer(y).isAllSolid();
+    // Only the row of a side neighbour touching the layer can hide its faces
+    auto adjIsSolid = [&](ChunkSection::Neighbour side) {
+        constexpr uint64_t ROW = (uint64_t(1) << CHUNK_SIZE) - 1;
+        int first = y * CHUNK_SIZE;
+        uint64_t word = m_pSnapshot->getOpaqueFace(side).getWord(first / 64);
+        return ((word >> (first % 64)) & ROW) == ROW;
     };
 
-    return (!m_pChunk->getLayer(y).isAllSolid()) ||
-           (!m_pChunk->getLayer(y + 1).isAllSolid()) ||
-           (!m_pChunk->getLayer(y - 1).isAllSolid()) ||
+    return (!m_pSnapshot->isLayerOpaque(y)) ||
+           (!m_pSnapshot->isLayerOpaque(y + 1)) ||
+           (!m_pSnapshot->isLayerOpaque(y - 1)) ||
 
-           (!adjIsSolid(1, 0)) || (!adjIsSolid(0, 1)) || (!adjIsSolid(-1, 0)) ||
-           (!adjIsSolid(0, -1));
+           (!adjIsSolid(ChunkSection::PosX)) ||
+           (!adjIsSolid(ChunkSection::PosZ)) ||
+           (!adjIsSolid(ChunkSection::NegX)) ||
+           (!adjIsSolid(ChunkSection::NegZ));
 }
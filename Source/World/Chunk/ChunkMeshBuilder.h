@@ -1,45 +1,81 @@
 #ifndef CHUNKMESHBUILDER_H_INCLUDED
 #define CHUNKMESHBUILDER_H_INCLUDED
 
-#include <glad/glad.h>
-
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <array>
 #include <vector>
 
 #include "../Block/ChunkBlock.h"
 
-class ChunkSection;
 class ChunkMesh;
+class SectionSnapshot;
 class BlockData;
 
 struct ChunkMeshCollection;
 struct BlockDataHolder;
+struct Config;
 
 class ChunkMeshBuilder {
   public:
-    ChunkMeshBuilder(ChunkSection &chunk, ChunkMeshCollection &meshes);
+    /// @brief Totals over every mesh built since they were last taken.
+    struct Statistics {
+        int sections = 0;
+        int faces = 0;
+        float buildSeconds = 0;
+    };
+
+    /// @brief The ways a section can be meshed.
+    enum class Mode {
+        /// One quad per face, checking the six neighbours of every block.
+        PerFace,
+        /// Neighbouring faces of the same block type merged into larger quads.
+        Greedy,
+        /// One quad per face, found with bit operations on columns of cells.
+        Columns,
+    };
+
+    /**
+     * @brief Creates a builder for the meshes of a captured section.
+     *
+     * @details
+     * Only the snapshot is read while building, so the section and its
+     * neighbours can change or be meshed by another thread meanwhile.
+     */
+    ChunkMeshBuilder(const SectionSnapshot &snapshot,
+                     ChunkMeshCollection &meshes);
 
-    void buildMesh();
+    void buildMesh(Mode mode = Mode::PerFace);
+
+    /// @brief Gets the mode chosen in the config.
+    static Mode getMode(const Config &config);
+
+    /// @brief Returns the statistics gathered so far and resets them.
+    static Statistics takeStatistics();
 
   private:
+    void buildBlockMesh();
+    void buildUniformMesh(ChunkBlock block);
+    void buildGreedyMesh();
+    void buildColumnMesh();
+
     void setActiveMesh(ChunkBlock block);
 
     void addXBlockToMesh(const sf::Vector2i &textureCoords,
                          const sf::Vector3i &blockPosition);
 
-    void tryAddFaceToMesh(const std::array<GLfloat, 12> &blockFace,
+    void tryAddFaceToMesh(const std::array<float, 12> &blockFace,
                           const sf::Vector2i &textureCoords,
                           const sf::Vector3i &blockPosition,
                           const sf::Vector3i &blockFacing,
-                          GLfloat cardinalLight);
+                          float cardinalLight);
 
     bool shouldMakeFace(const sf::Vector3i &blockPosition,
                         const BlockDataHolder &blockData);
 
     bool shouldMakeLayer(int y);
 
-    const ChunkBlock *m_pBlockPtr = nullptr;
-    ChunkSection *m_pChunk = nullptr;
+    const SectionSnapshot *m_pSnapshot = nullptr;
     ChunkMeshCollection *m_pMeshes = nullptr;
     ChunkMesh *m_pActiveMesh = nullptr;
     const BlockDataHolder *m_pBlockData = nullptr;
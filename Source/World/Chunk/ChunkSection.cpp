@@ -4,41 +4,136 @@
 
 #include "../World.h"
 #include "ChunkMeshBuilder.h"
+#include "SectionSnapshot.h"
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <thread>
 
-ChunkSection::ChunkSection(const sf::Vector3i &location, World &world)
+ChunkSection::ChunkSection(const sf::Vector3i &location, World *world)
     : m_aabb({CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE})
     , m_location(location)
-    , m_pWorld(&world)
+    , m_pWorld(world)
 {
     m_aabb.update({location.x * CHUNK_SIZE, location.y * CHUNK_SIZE,
                    location.z * CHUNK_SIZE});
 }
 
+ChunkSection::~ChunkSection()
+{
+    for (int i = 0; i < NUM_NEIGHBOURS; i++) {
+        linkNeighbour(static_cast<Neighbour>(i), nullptr);
+    }
+}
+
 void ChunkSection::setBlock(int x, int y, int z, ChunkBlock block)
 {
     if (outOfBounds(x) || outOfBounds(y) || outOfBounds(z)) {
-        auto location = toWorldPosition(x, y, z);
-        m_pWorld->setBlock(location.x, location.y, location.z, block);
+        if (m_pWorld) {
+            auto location = toWorldPosition(x, y, z);
+            m_pWorld->setBlock(location.x, location.y, location.z, block);
+        }
         return;
     }
 
-    m_layers[y].update(block);
+    updateMasks(x, y, z, block);
+
+    m_blocks.set(getIndex(x, y, z), block.id);
+}
+
+void ChunkSection::fillBox(int minX, int minY, int minZ, int maxX, int maxY,
+                           int maxZ, ChunkBlock block)
+{
+    if (minX >= maxX || minY >= maxY || minZ >= maxZ) {
+        return;
+    }
+
+    bool isOpaque = block.getData().isOpaque;
+    bool isNonAir = block != BlockId::Air;
+
+    // Runs along x, merged across z and then y where the box spans them
+    int runLength = maxX - minX;
+    int runsPerLayer = maxZ - minZ;
+    int layers = maxY - minY;
+    if (runLength == CHUNK_SIZE) {
+        runLength *= runsPerLayer;
+        runsPerLayer = 1;
+
+        if (runLength == CHUNK_AREA) {
+            runLength *= layers;
+            layers = 1;
+        }
+    }
+
+    for (int y = minY; y < minY + layers; y++)
+        for (int z = minZ; z < minZ + runsPerLayer; z++) {
+            int first = getIndex(minX, y, z);
+            m_blocks.fill(first, runLength, block.id);
+            m_opaqueMask.setRange(first, runLength, isOpaque);
+            m_nonAirMask.setRange(first, runLength, isNonAir);
+        }
+
+    auto fillFace = [&](Neighbour face, int x0, int x1, int y0, int y1, int z0,
+                        int z1) {
+        for (int y = y0; y < y1; y++)
+            for (int z = z0; z < z1; z++)
+                for (int x = x0; x < x1; x++) {
+                    int faceIndex = getFaceIndex(face, x, y, z);
+                    m_opaqueFaces[face].set(faceIndex, isOpaque);
+                    m_nonAirFaces[face].set(faceIndex, isNonAir);
+                }
+    };
 
-    m_blocks[getIndex(x, y, z)] = block;
+    if (minX == 0)
+        fillFace(NegX, 0, 1, minY, maxY, minZ, maxZ);
+    if (maxX == CHUNK_SIZE)
+        fillFace(PosX, 0, 1, minY, maxY, minZ, maxZ);
+
+    if (minY == 0)
+        fillFace(NegY, minX, maxX, 0, 1, minZ, maxZ);
+    if (maxY == CHUNK_SIZE)
+        fillFace(PosY, minX, maxX, 0, 1, minZ, maxZ);
+
+    if (minZ == 0)
+        fillFace(NegZ, minX, maxX, minY, maxY, 0, 1);
+    if (maxZ == CHUNK_SIZE)
+        fillFace(PosZ, minX, maxX, minY, maxY, 0, 1);
 }
 
 ChunkBlock ChunkSection::getBlock(int x, int y, int z) const
 {
-    if (outOfBounds(x) || outOfBounds(y) || outOfBounds(z)) {
+    bool outX = outOfBounds(x);
+    bool outY = outOfBounds(y);
+    bool outZ = outOfBounds(z);
+
+    // A block just across one face is read through the neighbour link
+    if (outX + outY + outZ == 1) {
+        int value = outX ? x : outY ? y : z;
+        if (value >= -CHUNK_SIZE && value < CHUNK_SIZE * 2) {
+            int axis = outX ? NegX : outY ? NegY : NegZ;
+            auto direction = static_cast<Neighbour>(axis + (value >= 0));
+
+            const ChunkSection *section = m_neighbours[direction];
+            if (!section) {
+                return BlockId::Air;
+            }
+
+            int wrap = value < 0 ? CHUNK_SIZE : -CHUNK_SIZE;
+            return section->getBlock(x + outX * wrap, y + outY * wrap,
+                                     z + outZ * wrap);
+        }
+    }
+
+    if (outX || outY || outZ) {
+        if (!m_pWorld) {
+            return BlockId::Air;
+        }
         auto location = toWorldPosition(x, y, z);
         return m_pWorld->getBlock(location.x, location.y, location.z);
     }
 
-    return m_blocks[getIndex(x, y, z)];
+    return m_blocks.get(getIndex(x, y, z));
 }
 
 const sf::Vector3i ChunkSection::getLocation() const
@@ -46,6 +141,26 @@ const sf::Vector3i ChunkSection::getLocation() const
     return m_location;
 }
 
+const AABB &ChunkSection::getBounds() const noexcept
+{
+    return m_aabb;
+}
+
+bool ChunkSection::isUniform() const
+{
+    return m_blocks.isUniform();
+}
+
+ChunkBlock ChunkSection::getUniformBlock() const
+{
+    return m_blocks.getUniformBlock();
+}
+
+std::size_t ChunkSection::getMemoryUsage() const noexcept
+{
+    return sizeof(*this) - sizeof(m_blocks) + m_blocks.getMemoryUsage();
+}
+
 bool ChunkSection::hasMesh() const
 {
     return m_hasMesh;
@@ -64,57 +179,199 @@ sf::Vector3i ChunkSection::toWorldPosition(int x, int y, int z) const
 
 void ChunkSection::makeMesh()
 {
-    ChunkMeshBuilder(*this, m_meshes).buildMesh();
+    auto mode = ChunkMeshBuilder::getMode(m_pWorld->getConfig());
+
+    // Copy everything the mesher reads first, so building the mesh never
+    // reaches into neighbouring sections or the world
+    SectionSnapshot snapshot;
+    snapshot.capture(*this);
+
+    // Any mesh still being built elsewhere is older than this one
+    startMesh();
+    ChunkMeshBuilder(snapshot, m_meshes).buildMesh(mode);
     m_hasMesh = true;
     m_hasBufferedMesh = false;
+    m_isMeshQueued = false;
 }
 
-void ChunkSection::bufferMesh()
+unsigned ChunkSection::startMesh()
 {
-    m_meshes.solidMesh.bufferMesh();
-    m_meshes.waterMesh.bufferMesh();
-    m_meshes.floraMesh.bufferMesh();
-    m_hasBufferedMesh = true;
+    static std::atomic<unsigned> nextRevision{1};
+
+    m_meshRevision = nextRevision++;
+    m_isMeshQueued = true;
+    return m_meshRevision;
 }
 
-const ChunkSection::Layer &ChunkSection::getLayer(int y) const
+bool ChunkSection::isMeshQueued() const
 {
-    if (y == -1) {
-        return m_pWorld->getChunkManager()
-            .getChunk(m_location.x, m_location.z)
-            .getSection(m_location.y - 1)
-            .getLayer(CHUNK_SIZE - 1);
+    return m_isMeshQueued;
+}
+
+void ChunkSection::cancelMesh(unsigned revision)
+{
+    if (revision == m_meshRevision) {
+        m_isMeshQueued = false;
     }
-    else if (y == CHUNK_SIZE) {
-        return m_pWorld->getChunkManager()
-            .getChunk(m_location.x, m_location.z)
-            .getSection(m_location.y + 1)
-            .getLayer(0);
+}
+
+bool ChunkSection::setMesh(ChunkMeshCollection &&meshes, unsigned revision)
+{
+    if (revision != m_meshRevision) {
+        return false;
+    }
+
+    m_meshHandle.reset();
+    m_meshes = std::move(meshes);
+
+    m_hasMesh = true;
+    m_hasBufferedMesh = false;
+    m_isMeshQueued = false;
+    return true;
+}
+
+void ChunkSection::bufferMesh(IChunkRenderer &renderer)
+{
+    m_meshHandle = renderer.bufferMesh(m_meshes);
+    m_meshes.solidMesh.clearData();
+    m_meshes.waterMesh.clearData();
+    m_meshes.floraMesh.clearData();
+    m_hasBufferedMesh = true;
+}
+
+std::unique_ptr<IChunkMeshHandle> ChunkSection::releaseMeshHandle()
+{
+    m_hasBufferedMesh = false;
+    return std::move(m_meshHandle);
+}
+
+const IChunkMeshHandle &ChunkSection::getMeshHandle() const
+{
+    return *m_meshHandle;
+}
+
+bool ChunkSection::isLayerOpaque(int y) const
+{
+    constexpr int WORDS_PER_LAYER = CHUNK_AREA / 64;
+
+    if (y == -1 || y == CHUNK_SIZE) {
+        // Sections that do not exist are air, so none of their layers are solid
+        const ChunkSection *section = m_neighbours[y == -1 ? NegY : PosY];
+        return section && section->isLayerOpaque(y == -1 ? CHUNK_SIZE - 1 : 0);
     }
-    else {
-        return m_layers[y];
+
+    return m_opaqueMask.allWords(y * WORDS_PER_LAYER, WORDS_PER_LAYER);
+}
+
+const ChunkSection::BlockMask &ChunkSection::getOpaqueMask() const noexcept
+{
+    return m_opaqueMask;
+}
+
+const ChunkSection::BlockMask &ChunkSection::getNonAirMask() const noexcept
+{
+    return m_nonAirMask;
+}
+
+const ChunkSection::FaceMask &
+ChunkSection::getOpaqueFace(Neighbour face) const noexcept
+{
+    return m_opaqueFaces[face];
+}
+
+const ChunkSection::FaceMask &
+ChunkSection::getNonAirFace(Neighbour face) const noexcept
+{
+    return m_nonAirFaces[face];
+}
+
+int ChunkSection::getFaceIndex(Neighbour face, int x, int y, int z) noexcept
+{
+    switch (face) {
+        case NegX:
+        case PosX:
+            return y * CHUNK_SIZE + z;
+
+        case NegY:
+        case PosY:
+            return z * CHUNK_SIZE + x;
+
+        default:
+            return y * CHUNK_SIZE + x;
     }
 }
 
+void ChunkSection::updateMasks(int x, int y, int z, ChunkBlock block)
+{
+    int index = getIndex(x, y, z);
+    bool isOpaque = block.getData().isOpaque;
+    bool isNonAir = block != BlockId::Air;
+
+    m_opaqueMask.set(index, isOpaque);
+    m_nonAirMask.set(index, isNonAir);
+
+    auto updateFace = [&](Neighbour face) {
+        int faceIndex = getFaceIndex(face, x, y, z);
+        m_opaqueFaces[face].set(faceIndex, isOpaque);
+        m_nonAirFaces[face].set(faceIndex, isNonAir);
+    };
+
+    if (x == 0)
+        updateFace(NegX);
+    else if (x == CHUNK_SIZE - 1)
+        updateFace(PosX);
+
+    if (y == 0)
+        updateFace(NegY);
+    else if (y == CHUNK_SIZE - 1)
+        updateFace(PosY);
+
+    if (z == 0)
+        updateFace(NegZ);
+    else if (z == CHUNK_SIZE - 1)
+        updateFace(PosZ);
+}
+
 void ChunkSection::deleteMeshes()
 {
+    // Meshes still being built are out of date as well
+    m_meshRevision = 0;
+    m_isMeshQueued = false;
+
     if (m_hasMesh) {
         m_hasBufferedMesh = false;
         m_hasMesh = false;
-        m_meshes.solidMesh.deleteData();
-        m_meshes.waterMesh.deleteData();
-        m_meshes.floraMesh.deleteData();
+        m_meshHandle.reset();
+        m_meshes = {};
     }
 }
 
-ChunkSection &ChunkSection::getAdjacent(int dx, int dz)
+const ChunkSection *ChunkSection::getAdjacent(int dx, int dz) const
 {
-    int newX = m_location.x + dx;
-    int newZ = m_location.z + dz;
+    if (dx != 0) {
+        return m_neighbours[dx < 0 ? NegX : PosX];
+    }
+    return m_neighbours[dz < 0 ? NegZ : PosZ];
+}
 
-    return m_pWorld->getChunkManager()
-        .getChunk(newX, newZ)
-        .getSection(m_location.y);
+ChunkSection *ChunkSection::getNeighbour(Neighbour direction) const noexcept
+{
+    return m_neighbours[direction];
+}
+
+void ChunkSection::linkNeighbour(Neighbour direction,
+                                 ChunkSection *section) noexcept
+{
+    auto opposite = static_cast<Neighbour>(direction ^ 1);
+
+    if (ChunkSection *old = m_neighbours[direction]) {
+        old->m_neighbours[opposite] = nullptr;
+    }
+
+    m_neighbours[direction] = section;
+    if (section) {
+        section->m_neighbours[opposite] = this;
+    }
 }
 
 bool ChunkSection::outOfBounds(int value)
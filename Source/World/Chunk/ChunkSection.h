@@ -1,89 +1,217 @@
 #ifndef CHUNKSECTION_H_INCLUDED
 #define CHUNKSECTION_H_INCLUDED
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector3.hpp>
 #include <array>
+#include <atomic>
 
 #include "../Block/ChunkBlock.h"
 #include "../WorldConstants.h"
 #include "ChunkMesh.h"
 #include "IChunk.h"
+#include "IChunkRenderer.h"
+#include "PalettedBlockStorage.h"
 
 #include "../../Physics/AABB.h"
+#include "../../Util/BitMask.h"
 #include "../Block/BlockData.h"
 
 class World;
 
+/**
+ * @class ChunkSection
+ * @brief A 16x16x16 cube of blocks, the unit chunks are meshed and drawn in.
+ *
+ * @details
+ * Besides the blocks themselves, a section keeps bit masks of which cells
+ * hold an opaque block and which hold anything but air, indexed the same way
+ * as the blocks. For each of the six faces it also keeps masks of the opaque
+ * and non-air cells on that boundary plane, so a neighbour can check whether
+ * the face hides it without reading any blocks. All masks are updated on every write.
+ */
 class ChunkSection : public IChunk {
     friend class Chunk;
 
-    class Layer {
-      public:
-        void update(ChunkBlock c)
-        {
-            if (c.getData().isOpaque) {
-                m_solidBlockCount--;
-            }
-            else {
-                m_solidBlockCount++;
-            }
-        }
-
-        bool isAllSolid() const
-        {
-            return m_solidBlockCount == CHUNK_AREA;
-        }
-
-      private:
-        int m_solidBlockCount = 0;
-    };
-
   public:
-    ChunkSection(const sf::Vector3i &position, World &world);
+    /**
+     * @brief The six face neighbours of a section.
+     *
+     * @details
+     * Opposite directions differ only in the lowest bit, so the opposite of
+     * a direction is (direction ^ 1).
+     */
+    enum Neighbour { NegX, PosX, NegY, PosY, NegZ, PosZ, NUM_NEIGHBOURS };
+
+    using BlockMask = BitMask<CHUNK_VOLUME>;
+    using FaceMask = BitMask<CHUNK_AREA>;
+
+    /// @param world The world the section is in, or nullptr for a section of
+    ///              a chunk generated outside of any world.
+    ChunkSection(const sf::Vector3i &position, World *world);
+    ~ChunkSection();
 
     void setBlock(int x, int y, int z, ChunkBlock block) override;
     ChunkBlock getBlock(int x, int y, int z) const override;
 
+    /**
+     * @brief Sets every block in a box to the same block.
+     *
+     * @details
+     * The box runs from (minX, minY, minZ) up to but not including
+     * (maxX, maxY, maxZ) and must lie within the section. The block data is
+     * looked up once, and the blocks and masks are written in contiguous
+     * runs along x, or along whole layers where the box spans them. A box
+     * covering the whole section replaces its storage outright.
+     */
+    void fillBox(int minX, int minY, int minZ, int maxX, int maxY, int maxZ,
+                 ChunkBlock block);
+
     const sf::Vector3i getLocation() const;
 
+    /// @brief Gets the box the section covers in the world.
+    const AABB &getBounds() const noexcept;
+
+    /// @brief Checks if the section is filled with a single block type.
+    bool isUniform() const;
+    ChunkBlock getUniformBlock() const;
+
+    /// @brief Gets the number of bytes used by the section and its blocks,
+    /// not counting its meshes.
+    std::size_t getMemoryUsage() const noexcept;
+
     bool hasMesh() const;
     bool hasBuffered() const;
 
+    /// @brief Builds the mesh on the calling thread.
     void makeMesh();
-    void bufferMesh();
 
-    const Layer &getLayer(int y) const;
-    ChunkSection &getAdjacent(int dx, int dz);
+    /**
+     * @brief Hands the mesh to the renderer to be copied into GPU buffers.
+     *
+     * @details
+     * The vertex data is freed afterwards; the section keeps the handle the
+     * renderer returned until its mesh changes.
+     */
+    void bufferMesh(IChunkRenderer &renderer);
+
+    /// @brief Gets the buffered mesh; only valid once hasBuffered is true.
+    const IChunkMeshHandle &getMeshHandle() const;
+
+    /// @brief Takes the buffered mesh out of the section, so the section can
+    /// be destroyed away from the GL thread.
+    /// @return The mesh, or nullptr if none was buffered.
+    std::unique_ptr<IChunkMeshHandle> releaseMeshHandle();
+
+    /**
+     * @brief Marks the section as having a mesh being built elsewhere.
+     *
+     * @return The revision to hand to setMesh with the finished mesh.
+     *
+     * @details
+     * Each call starts a new revision, so a mesh that was still being built
+     * when the section changed again is dropped instead of replacing a newer
+     * one. Revisions are unique across sections, so a mesh is never taken by
+     * a different section that was created at the same location.
+     */
+    unsigned startMesh();
+
+    /// @brief Checks if a mesh started with startMesh has not arrived yet.
+    bool isMeshQueued() const;
+
+    /// @brief Clears the mark set by startMesh for a mesh that will not be
+    /// built, unless a newer one has been started since.
+    void cancelMesh(unsigned revision);
+
+    /**
+     * @brief Replaces the section's meshes with ones built from a snapshot.
+     *
+     * @return False if the meshes are out of date and were dropped.
+     *
+     * @details
+     * Must be called on the GL thread, as it frees the old buffers.
+     */
+    bool setMesh(ChunkMeshCollection &&meshes, unsigned revision);
+
+    /**
+     * @brief Checks if every block in a layer is opaque.
+     *
+     * @param y The layer, in the range [-1, CHUNK_SIZE]. The layers just
+     *          outside the section are looked up in the sections above and
+     *          below.
+     */
+    bool isLayerOpaque(int y) const;
+
+    const BlockMask &getOpaqueMask() const noexcept;
+    const BlockMask &getNonAirMask() const noexcept;
+
+    /**
+     * @brief Gets the opaque cells on the boundary plane facing a direction.
+     *
+     * @details
+     * Bits are indexed by getFaceIndex. A fully set mask means the face
+     * hides everything behind it.
+     */
+    const FaceMask &getOpaqueFace(Neighbour face) const noexcept;
+
+    /// @brief Gets the non-air cells on the boundary plane facing a direction.
+    const FaceMask &getNonAirFace(Neighbour face) const noexcept;
+
+    /**
+     * @brief Gets the index of a boundary cell within a face mask.
+     *
+     * @details
+     * The coordinate along the face's axis is ignored. X faces are indexed by
+     * (y, z), Y faces by (z, x) and Z faces by (y, x), the first one being
+     * the most significant.
+     */
+    static int getFaceIndex(Neighbour face, int x, int y, int z) noexcept;
+
+    /// @brief Gets the index of a block within the section and its masks.
+    static int getIndex(int x, int y, int z);
+    /// @brief Gets the horizontally adjacent section, or nullptr if it is air.
+    const ChunkSection *getAdjacent(int dx, int dz) const;
 
-    const ChunkMeshCollection &getMeshes() const
-    {
-        return m_meshes;
-    }
+    /**
+     * @brief Gets the section sharing the given face with this one.
+     *
+     * @return The neighbour, or nullptr if it is air or its chunk is not
+     *         loaded.
+     */
+    ChunkSection *getNeighbour(Neighbour direction) const noexcept;
 
     void deleteMeshes();
 
-    const ChunkBlock *begin()
-    {
-        return &m_blocks[0];
-    }
-
   private:
+    /// @brief Links both sections to each other; a nullptr clears the link.
+    void linkNeighbour(Neighbour direction, ChunkSection *section) noexcept;
+    void updateMasks(int x, int y, int z, ChunkBlock block);
+
     sf::Vector3i toWorldPosition(int x, int y, int z) const;
 
     static bool outOfBounds(int value);
-    static int getIndex(int x, int y, int z);
 
-    std::array<ChunkBlock, CHUNK_VOLUME> m_blocks;
-    std::array<Layer, CHUNK_SIZE> m_layers;
+    PalettedBlockStorage m_blocks;
+    BlockMask m_opaqueMask;
+    BlockMask m_nonAirMask;
+    std::array<FaceMask, NUM_NEIGHBOURS> m_opaqueFaces;
+    std::array<FaceMask, NUM_NEIGHBOURS> m_nonAirFaces;
 
     ChunkMeshCollection m_meshes;
+    std::unique_ptr<IChunkMeshHandle> m_meshHandle;
     AABB m_aabb;
     sf::Vector3i m_location;
 
+    // Atomic, as other threads follow them while sections are linked
+    // and unlinked
+    std::array<std::atomic<ChunkSection *>, NUM_NEIGHBOURS> m_neighbours{};
+
     World *m_pWorld;
 
+    unsigned m_meshRevision = 0;
+
     bool m_hasMesh = false;
     bool m_hasBufferedMesh = false;
+    bool m_isMeshQueued = false;
 };
 
 #endif // CHUNKSECTION_H_INCLUDED
@@ -0,0 +1,35 @@
+#ifndef CHUNKSTATUS_H_INCLUDED
+#define CHUNKSTATUS_H_INCLUDED
+
+#include <cstdint>
+
+/**
+ * @enum ChunkStatus
+ * @brief How far a chunk has come on its way from nothing to being drawn.
+ *
+ * @details
+ * The stages up to Decorated are the generation stages, each run as its own
+ * job by the GenerationPipeline. Biomes and Heights only compute the layout
+ * of the chunk; Surface and Decorated write its blocks, and a chunk counts as
+ * loaded once it is decorated. Meshes are built and uploaded for each section
+ * separately, so a chunk is only Meshed or Uploaded once all of its sections
+ * are.
+ */
+enum class ChunkStatus : uint8_t {
+    Empty,
+    Biomes,    // The biome of every column is known
+    Heights,   // The height of every column and the structures growing from
+               // the chunk are known
+    Surface,   // The terrain and plants are written
+    Decorated, // The structures of the chunk and its neighbours are written
+    Meshed,
+    Uploaded,
+};
+
+/// @brief Gets the stage after the given one.
+inline ChunkStatus nextStatus(ChunkStatus status) noexcept
+{
+    return static_cast<ChunkStatus>(static_cast<uint8_t>(status) + 1);
+}
+
+#endif // CHUNKSTATUS_H_INCLUDED
@@ -0,0 +1,20 @@
+#include "ChunkStorage.h"
+
+#include "Chunk.h"
+
+void ChunkStorage::linkNeighbours(Chunk &chunk)
+{
+    auto location = chunk.getLocation();
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dz = -1; dz <= 1; dz++) {
+            if (dx == 0 && dz == 0) {
+                continue;
+            }
+
+            if (Chunk *neighbour = find(location.x + dx, location.y + dz)) {
+                chunk.linkNeighbour(dx, dz, *neighbour);
+            }
+        }
+    }
+}
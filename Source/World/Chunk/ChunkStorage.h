@@ -0,0 +1,68 @@
+#ifndef CHUNKSTORAGE_H_INCLUDED
+#define CHUNKSTORAGE_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+class Chunk;
+class World;
+
+/**
+ * @class ChunkStorage
+ * @brief Abstract base class for the containers holding the loaded chunks.
+ *
+ * @details
+ * The ChunkManager owns exactly one storage, chosen when it is created. The
+ * storage decides how chunks are found by their chunk coordinate, and which
+ * chunks are dropped when the area around the player moves.
+ */
+class ChunkStorage {
+  public:
+    using DropFunction = std::function<void(Chunk &)>;
+
+    virtual ~ChunkStorage() = default;
+
+    /**
+     * @brief Finds the chunk at the given chunk coordinate.
+     *
+     * @return The chunk, or nullptr if it has not been created.
+     */
+    virtual Chunk *find(int x, int z) noexcept = 0;
+    virtual const Chunk *find(int x, int z) const noexcept = 0;
+
+    /**
+     * @brief Finds the chunk at the given chunk coordinate, creating it if
+     * needed.
+     *
+     * @return The chunk, or nullptr if the storage cannot hold a chunk at
+     *         that coordinate.
+     */
+    virtual Chunk *findOrCreate(int x, int z, World &world) = 0;
+
+    /// @brief Destroys the chunk at the given chunk coordinate, if any.
+    virtual void erase(int x, int z) = 0;
+
+    /**
+     * @brief Moves the centre of the loaded area.
+     *
+     * @param x The chunk x coordinate the player is in.
+     * @param z The chunk z coordinate the player is in.
+     * @param onDrop Called with each chunk about to be destroyed.
+     *
+     * @details
+     * Chunks further than the storage's radius away from the new centre, on
+     * either axis, are destroyed.
+     */
+    virtual void setCentre(int x, int z, const DropFunction &onDrop) = 0;
+
+    /// @brief Calls the function with every chunk in the storage.
+    virtual void forEach(const std::function<void(Chunk &)> &function) = 0;
+
+    virtual std::size_t size() const noexcept = 0;
+
+  protected:
+    /// @brief Links a newly created chunk to its loaded neighbours.
+    void linkNeighbours(Chunk &chunk);
+};
+
+#endif // CHUNKSTORAGE_H_INCLUDED
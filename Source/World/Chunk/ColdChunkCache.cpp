@@ -0,0 +1,224 @@
+#include "ColdChunkCache.h"
+
+#include <algorithm>
+
+#include "Chunk.h"
+#include "ChunkSection.h"
+
+namespace {
+// Writes the blocks [first, first + count) of a section, in whole rows and
+// layers where the run covers them
+void fillRun(Chunk &chunk, int sectionIndex, int first, int count,
+             ChunkBlock block)
+{
+    int base = sectionIndex * CHUNK_SIZE;
+    while (count > 0) {
+        int x = first % CHUNK_SIZE;
+        int z = first / CHUNK_SIZE % CHUNK_SIZE;
+        int y = first / CHUNK_AREA;
+
+        int length;
+        if (x != 0 || count < CHUNK_SIZE) {
+            length = std::min(count, CHUNK_SIZE - x);
+            chunk.fillBox(x, base + y, z, x + length, base + y + 1, z + 1, block);
+        }
+        else if (z != 0 || count < CHUNK_AREA) {
+            int rows = std::min(count / CHUNK_SIZE, CHUNK_SIZE - z);
+            length = rows * CHUNK_SIZE;
+            chunk.fillBox(0, base + y, z, CHUNK_SIZE, base + y + 1, z + rows, block);
+        }
+        else {
+            int layers = count / CHUNK_AREA;
+            length = layers * CHUNK_AREA;
+            chunk.fillBox(0, base + y, 0, CHUNK_SIZE, base + y + layers, CHUNK_SIZE,
+                          block);
+        }
+
+        first += length;
+        count -= length;
+    }
+}
+} // namespace
+
+ColdChunkCache::ColdChunkCache(std::size_t capacityBytes)
+    : m_capacity(capacityBytes)
+{
+}
+
+void ColdChunkCache::store(const sf::Vector2i &location, const Sections &sections)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    // Compressed before locking, as it reads every block
+    Entry entry = compress(sections);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    insert(location, std::move(entry));
+    m_statistics.stored++;
+}
+
+void ColdChunkCache::storePending(const sf::Vector2i &location,
+                                  std::shared_ptr<const Sections> sections)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    // Counted at its compressed size once compressed
+    Entry entry{{}, sizeof(Entry), 0, {}, std::move(sections)};
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    insert(location, std::move(entry));
+    m_statistics.stored++;
+}
+
+void ColdChunkCache::compressPending(const sf::Vector2i &location,
+                                     const std::shared_ptr<const Sections> &sections)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    Entry entry = compress(*sections);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Entry *pending = m_entries.find(location.x, location.y);
+    if (pending && pending->pending == sections) {
+        insert(location, std::move(entry));
+    }
+}
+
+std::unique_ptr<Chunk> ColdChunkCache::take(int x, int z)
+{
+    std::vector<CompressedSection> sections;
+    std::shared_ptr<const Sections> pending;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Entry *entry = m_entries.find(x, z);
+        if (!entry) {
+            return nullptr;
+        }
+
+        sections = std::move(entry->sections);
+        pending = std::move(entry->pending);
+        erase(x, z);
+        m_statistics.hits++;
+    }
+
+    // Taken before the teardown thread got to it
+    if (pending) {
+        sections = compress(*pending).sections;
+    }
+
+    // Sections start as air, so only the other runs are written
+    auto chunk = std::make_unique<Chunk>(sf::Vector2i(x, z));
+    for (auto &section : sections) {
+        int first = 0;
+        for (auto &run : section.runs) {
+            if (run.block != static_cast<Block_t>(BlockId::Air)) {
+                fillRun(*chunk, section.index, first, run.length, run.block);
+            }
+            first += run.length;
+        }
+    }
+    return chunk;
+}
+
+void ColdChunkCache::putBack(Chunk &chunk)
+{
+    const sf::Vector2i &location = chunk.getLocation();
+    Entry entry = compress(chunk.releaseSections());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    insert(location, std::move(entry));
+    m_statistics.hits--;
+}
+
+void ColdChunkCache::recordMisses(int count)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_statistics.misses += count;
+}
+
+ColdChunkCache::Statistics ColdChunkCache::takeStatistics()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Statistics taken = m_statistics;
+    taken.chunks = (int)m_entries.size();
+    taken.bytes = m_bytes;
+    taken.uncompressedBytes = m_uncompressedBytes;
+    m_statistics = {};
+    return taken;
+}
+
+ColdChunkCache::Entry ColdChunkCache::compress(const Sections &sections)
+{
+    Entry entry{{}, sizeof(Entry), 0, {}};
+    for (auto &section : sections) {
+        if (section && !(section->isUniform() &&
+                         section->getUniformBlock() == BlockId::Air)) {
+            entry.sections.push_back(compress(*section));
+            entry.bytes += sizeof(CompressedSection) +
+                           entry.sections.back().runs.size() * sizeof(Run);
+        }
+    }
+    entry.uncompressedBytes = entry.sections.size() * CHUNK_VOLUME;
+    return entry;
+}
+
+ColdChunkCache::CompressedSection ColdChunkCache::compress(const ChunkSection &section)
+{
+    CompressedSection compressed{section.getLocation().y, {}};
+    if (section.isUniform()) {
+        compressed.runs.push_back({section.getUniformBlock().id, CHUNK_VOLUME});
+        return compressed;
+    }
+
+    // In index order, x first, then z, then y
+    for (int y = 0; y < CHUNK_SIZE; y++)
+        for (int z = 0; z < CHUNK_SIZE; z++)
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                Block_t block = section.getBlock(x, y, z).id;
+                auto &runs = compressed.runs;
+                if (!runs.empty() && runs.back().block == block) {
+                    runs.back().length++;
+                }
+                else {
+                    runs.push_back({block, 1});
+                }
+            }
+    compressed.runs.shrink_to_fit();
+    return compressed;
+}
+
+void ColdChunkCache::insert(const sf::Vector2i &location, Entry entry)
+{
+    erase(location.x, location.y);
+    if (entry.bytes > m_capacity) {
+        return;
+    }
+
+    while (m_bytes + entry.bytes > m_capacity) {
+        sf::Vector2i oldest = m_ages.back();
+        erase(oldest.x, oldest.y);
+        m_statistics.dropped++;
+    }
+
+    m_ages.push_front(location);
+    entry.age = m_ages.begin();
+    m_bytes += entry.bytes;
+    m_uncompressedBytes += entry.uncompressedBytes;
+    m_entries.tryEmplace(location.x, location.y, std::move(entry));
+}
+
+void ColdChunkCache::erase(int x, int z)
+{
+    if (Entry *entry = m_entries.find(x, z)) {
+        m_bytes -= entry->bytes;
+        m_uncompressedBytes -= entry->uncompressedBytes;
+        m_ages.erase(entry->age);
+        m_entries.erase(x, z);
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef COLDCHUNKCACHE_H_INCLUDED
+#define COLDCHUNKCACHE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "../../Util/NonCopyable.h"
+#include "../Block/BlockId.h"
+#include "FlatChunkMap.h"
+
+class Chunk;
+class ChunkSection;
+
+/**
+ * @class ColdChunkCache
+ * @brief Keeps the blocks of recently unloaded chunks in memory, compressed,
+ * so they load again without being generated.
+ *
+ * @details
+ * Each section is stored as runs of the same block in index order. Terrain
+ * is mostly layers of stone, air and water, so a section usually takes a
+ * few dozen runs instead of a byte per block. Edits are kept along with the
+ * terrain, for as long as the chunk stays in the cache.
+ *
+ * A chunk unloaded during a frame can be held uncompressed at first, with
+ * storePending, and compressed later on another thread. It counts as cached
+ * all along; taking it before then compresses it on the spot.
+ *
+ * The cache holds at most a fixed number of bytes, dropping the chunks that
+ * were unloaded longest ago first. Safe to use from any thread.
+ */
+class ColdChunkCache : public NonCopyable {
+  public:
+    using Sections = std::vector<std::unique_ptr<ChunkSection>>;
+
+    struct Statistics {
+        int hits = 0;   // Chunks loaded from the cache
+        int misses = 0; // Chunks that had to be generated
+        int stored = 0;
+        int dropped = 0; // Pushed out to make room
+        int chunks = 0;  // Chunks in the cache when the statistics were taken
+        std::size_t bytes = 0;
+        std::size_t uncompressedBytes = 0; // At a byte per block
+    };
+
+    /// @param capacityBytes The most bytes to hold, or 0 to hold nothing.
+    explicit ColdChunkCache(std::size_t capacityBytes);
+
+    /**
+     * @brief Compresses the sections of an unloaded chunk into the cache.
+     *
+     * @details
+     * Replaces any older copy of the chunk. The sections are only read, and
+     * must not be linked to sections still in use.
+     */
+    void store(const sf::Vector2i &location, const Sections &sections);
+
+    /**
+     * @brief Holds the sections of an unloaded chunk in the cache without
+     * compressing them yet.
+     *
+     * @details
+     * Replaces any older copy of the chunk, without reading a block. The
+     * sections are compressed by compressPending, or by take if the chunk
+     * is taken first, so they must not change or be linked to sections
+     * still in use.
+     */
+    void storePending(const sf::Vector2i &location,
+                      std::shared_ptr<const Sections> sections);
+
+    /// @brief Compresses sections held by storePending, unless the chunk has
+    /// been taken or stored again since.
+    void compressPending(const sf::Vector2i &location,
+                         const std::shared_ptr<const Sections> &sections);
+
+    /**
+     * @brief Takes the chunk at the given position out of the cache.
+     *
+     * @return A chunk outside of any world holding the cached blocks, or
+     *         nullptr if the chunk is not cached.
+     */
+    std::unique_ptr<Chunk> take(int x, int z);
+
+    /// @brief Stores a chunk taken out with take that could not be loaded
+    /// after all, no longer counting it as a hit.
+    void putBack(Chunk &chunk);
+
+    /// @brief Counts chunks that were generated because they were not cached.
+    void recordMisses(int count);
+
+    /// @brief Returns the statistics gathered so far and resets them.
+    Statistics takeStatistics();
+
+  private:
+    struct Run {
+        Block_t block;
+        uint16_t length;
+    };
+
+    struct CompressedSection {
+        int index;
+        std::vector<Run> runs;
+    };
+
+    struct Entry {
+        std::vector<CompressedSection> sections;
+        std::size_t bytes;
+        std::size_t uncompressedBytes;
+        std::list<sf::Vector2i>::iterator age;
+        std::shared_ptr<const Sections> pending = nullptr; // Not compressed yet
+    };
+
+    static Entry compress(const Sections &sections);
+    static CompressedSection compress(const ChunkSection &section);
+
+    // Called with the mutex held
+    void insert(const sf::Vector2i &location, Entry entry);
+    void erase(int x, int z);
+
+    // Most recently stored first
+    std::list<sf::Vector2i> m_ages;
+    FlatChunkMap<Entry> m_entries;
+
+    std::size_t m_capacity;
+    std::size_t m_bytes = 0;
+    std::size_t m_uncompressedBytes = 0;
+    Statistics m_statistics;
+
+    std::mutex m_mutex;
+};
+
+#endif // COLDCHUNKCACHE_H_INCLUDED
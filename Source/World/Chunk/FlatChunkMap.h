@@ -0,0 +1,297 @@
+#ifndef FLATCHUNKMAP_H_INCLUDED
+#define FLATCHUNKMAP_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FlatChunkMap
+ * @brief Open addressing hash map from chunk coordinates to chunk values.
+ *
+ * @details
+ * The chunk coordinates are packed into a single 64 bit key which is looked up
+ * in a flat, linearly probed table of (key, slot) pairs. Erasing uses
+ * backward shifting, so the table never fills up with tombstones.
+ *
+ * The values themselves are not stored in the table but in fixed size slabs,
+ * which means a value never moves once it has been inserted: growing the
+ * table only rehashes the small (key, slot) pairs. Pointers and references to
+ * values stay valid until the value is erased.
+ *
+ * @tparam T The type of value stored for each chunk coordinate.
+ */
+template <typename T>
+class FlatChunkMap {
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+    static constexpr uint32_t SLAB_SIZE = 64;
+
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t slot = EMPTY;
+    };
+
+    struct Node {
+        uint64_t key = 0;
+        std::optional<T> value;
+    };
+
+    using Slab = std::array<Node, SLAB_SIZE>;
+
+  public:
+    FlatChunkMap()
+    {
+        m_entries.resize(16);
+    }
+
+    /**
+     * @brief Packs a chunk coordinate into the 64 bit key used by the map.
+     */
+    static uint64_t packKey(int x, int z) noexcept
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+               static_cast<uint32_t>(z);
+    }
+
+    /**
+     * @brief Finds the value stored at the given chunk coordinate.
+     *
+     * @return A pointer to the value, or nullptr if there is none.
+     */
+    T *find(int x, int z) noexcept
+    {
+        uint32_t slot = findSlot(packKey(x, z));
+        return slot == EMPTY ? nullptr : &*node(slot).value;
+    }
+
+    const T *find(int x, int z) const noexcept
+    {
+        uint32_t slot = findSlot(packKey(x, z));
+        return slot == EMPTY ? nullptr : &*node(slot).value;
+    }
+
+    /**
+     * @brief Gets the value at the given coordinate, constructing it if needed.
+     *
+     * @param args Arguments forwarded to the constructor of T, only used if
+     *             there is no value at the coordinate yet.
+     *
+     * @return The value, and whether it was newly constructed.
+     *
+     * @details
+     * The key is hashed and probed once, no matter if the value already
+     * existed or not. The table only grows when a new value is inserted, in
+     * which case the key is probed again in the grown table.
+     */
+    template <typename... Args>
+    std::pair<T *, bool> tryEmplace(int x, int z, Args &&... args)
+    {
+        uint64_t key = packKey(x, z);
+        std::size_t mask = m_entries.size() - 1;
+        std::size_t i = hash(key) & mask;
+        for (; m_entries[i].slot != EMPTY; i = (i + 1) & mask) {
+            if (m_entries[i].key == key) {
+                return {&*node(m_entries[i].slot).value, false};
+            }
+        }
+
+        if ((m_size + 1) * 2 > m_entries.size()) {
+            grow();
+            mask = m_entries.size() - 1;
+            i = hash(key) & mask;
+            while (m_entries[i].slot != EMPTY) {
+                i = (i + 1) & mask;
+            }
+        }
+
+        Entry &entry = m_entries[i];
+        entry.key = key;
+        entry.slot = allocateSlot();
+
+        Node &n = node(entry.slot);
+        n.key = key;
+        n.value.emplace(std::forward<Args>(args)...);
+        m_size++;
+        return {&*n.value, true};
+    }
+
+    /**
+     * @brief Erases the value at the given coordinate, if there is one.
+     *
+     * @return True if a value was erased.
+     */
+    bool erase(int x, int z)
+    {
+        return eraseKey(packKey(x, z));
+    }
+
+    /**
+     * @brief Calls the function with every stored value.
+     *
+     * @details
+     * Values are visited in storage order rather than hash order, which walks
+     * the slabs front to back.
+     */
+    template <typename F>
+    void forEach(F &&function)
+    {
+        for (auto &slab : m_slabs) {
+            for (auto &n : *slab) {
+                if (n.value) {
+                    function(*n.value);
+                }
+            }
+        }
+    }
+
+    template <typename F>
+    void forEach(F &&function) const
+    {
+        for (auto &slab : m_slabs) {
+            for (auto &n : *slab) {
+                if (n.value) {
+                    function(*n.value);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Erases every value for which the predicate returns true.
+     */
+    template <typename Predicate>
+    void eraseIf(Predicate &&predicate)
+    {
+        for (auto &slab : m_slabs) {
+            for (auto &n : *slab) {
+                if (n.value && predicate(*n.value)) {
+                    eraseKey(n.key);
+                }
+            }
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    void clear()
+    {
+        m_entries.assign(16, Entry{});
+        m_slabs.clear();
+        m_freeSlots.clear();
+        m_size = 0;
+    }
+
+  private:
+    static std::size_t hash(uint64_t key) noexcept
+    {
+        // Fibonacci hashing; the high bits are the best mixed ones
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    Node &node(uint32_t slot) noexcept
+    {
+        return (*m_slabs[slot / SLAB_SIZE])[slot % SLAB_SIZE];
+    }
+
+    const Node &node(uint32_t slot) const noexcept
+    {
+        return (*m_slabs[slot / SLAB_SIZE])[slot % SLAB_SIZE];
+    }
+
+    uint32_t findSlot(uint64_t key) const noexcept
+    {
+        std::size_t mask = m_entries.size() - 1;
+        for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+            const Entry &entry = m_entries[i];
+            if (entry.slot == EMPTY || entry.key == key) {
+                return entry.slot;
+            }
+        }
+    }
+
+    bool eraseKey(uint64_t key)
+    {
+        std::size_t mask = m_entries.size() - 1;
+        std::size_t i = hash(key) & mask;
+        while (m_entries[i].key != key) {
+            if (m_entries[i].slot == EMPTY) {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+        if (m_entries[i].slot == EMPTY) {
+            return false;
+        }
+
+        uint32_t slot = m_entries[i].slot;
+        node(slot).value.reset();
+        m_freeSlots.push_back(slot);
+        m_size--;
+
+        // Shift following entries back so lookups never hit a gap too early
+        for (std::size_t j = (i + 1) & mask;; j = (j + 1) & mask) {
+            Entry &entry = m_entries[j];
+            if (entry.slot == EMPTY) {
+                break;
+            }
+
+            std::size_t home = hash(entry.key) & mask;
+            bool canMove = (j > i) ? (home <= i || home > j)
+                                   : (home <= i && home > j);
+            if (canMove) {
+                m_entries[i] = entry;
+                i = j;
+            }
+        }
+        m_entries[i] = Entry{};
+        return true;
+    }
+
+    uint32_t allocateSlot()
+    {
+        if (m_freeSlots.empty()) {
+            uint32_t first = static_cast<uint32_t>(m_slabs.size()) * SLAB_SIZE;
+            m_slabs.push_back(std::make_unique<Slab>());
+            for (uint32_t slot = first + SLAB_SIZE; slot > first; slot--) {
+                m_freeSlots.push_back(slot - 1);
+            }
+        }
+
+        uint32_t slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    void grow()
+    {
+        std::vector<Entry> old(m_entries.size() * 2);
+        old.swap(m_entries);
+
+        std::size_t mask = m_entries.size() - 1;
+        for (auto &entry : old) {
+            if (entry.slot == EMPTY) {
+                continue;
+            }
+
+            std::size_t i = hash(entry.key) & mask;
+            while (m_entries[i].slot != EMPTY) {
+                i = (i + 1) & mask;
+            }
+            m_entries[i] = entry;
+        }
+    }
+
+    std::vector<Entry> m_entries;
+    std::vector<std::unique_ptr<Slab>> m_slabs;
+    std::vector<uint32_t> m_freeSlots;
+    std::size_t m_size = 0;
+};
+
+#endif // FLATCHUNKMAP_H_INCLUDED
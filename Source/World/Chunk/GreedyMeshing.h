@@ -0,0 +1,71 @@
+#ifndef GREEDYMESHING_H_INCLUDED
+#define GREEDYMESHING_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+
+#include "../WorldConstants.h"
+
+/**
+ * @brief One slice through a chunk section, holding a face key per cell.
+ *
+ * @details
+ * Cells are indexed [v * CHUNK_SIZE + u]. A key of 0 means there is no face
+ * in that cell; faces with equal keys can be merged into one quad.
+ */
+using FaceSlice = std::array<uint16_t, CHUNK_AREA>;
+
+/**
+ * @brief Merges equal faces of a slice into as few rectangles as possible.
+ *
+ * @param slice The faces to merge. Every cell is reset to 0 as it is merged.
+ * @param emit  Called as emit(key, u, v, width, height) for each rectangle.
+ *
+ * @details
+ * Walks the slice row by row. From the first unmerged face, a rectangle is
+ * grown along u while the key stays the same, then along v while every cell
+ * of the next row matches too.
+ */
+template <typename F>
+void mergeFaces(FaceSlice &slice, F &&emit)
+{
+    for (int v = 0; v < CHUNK_SIZE; v++) {
+        for (int u = 0; u < CHUNK_SIZE;) {
+            uint16_t key = slice[v * CHUNK_SIZE + u];
+            if (key == 0) {
+                u++;
+                continue;
+            }
+
+            int width = 1;
+            while (u + width < CHUNK_SIZE &&
+                   slice[v * CHUNK_SIZE + u + width] == key) {
+                width++;
+            }
+
+            int height = 1;
+            for (; v + height < CHUNK_SIZE; height++) {
+                const uint16_t *row = &slice[(v + height) * CHUNK_SIZE + u];
+
+                int i = 0;
+                while (i < width && row[i] == key) {
+                    i++;
+                }
+                if (i < width) {
+                    break;
+                }
+            }
+
+            for (int dv = 0; dv < height; dv++) {
+                for (int du = 0; du < width; du++) {
+                    slice[(v + dv) * CHUNK_SIZE + u + du] = 0;
+                }
+            }
+
+            emit(key, u, v, width, height);
+            u += width;
+        }
+    }
+}
+
+#endif // GREEDYMESHING_H_INCLUDED
@@ -0,0 +1,64 @@
+#include "HashedChunkStorage.h"
+
+#include <cstdlib>
+
+HashedChunkStorage::HashedChunkStorage(int radius)
+    : m_radius(radius)
+{
+}
+
+Chunk *HashedChunkStorage::find(int x, int z) noexcept
+{
+    return m_chunks.find(x, z);
+}
+
+const Chunk *HashedChunkStorage::find(int x, int z) const noexcept
+{
+    return m_chunks.find(x, z);
+}
+
+Chunk *HashedChunkStorage::findOrCreate(int x, int z, World &world)
+{
+    auto [chunk, isNew] = m_chunks.tryEmplace(x, z, world, sf::Vector2i(x, z));
+    if (isNew) {
+        linkNeighbours(*chunk);
+    }
+    return chunk;
+}
+
+void HashedChunkStorage::erase(int x, int z)
+{
+    m_chunks.erase(x, z);
+}
+
+void HashedChunkStorage::setCentre(int x, int z, const DropFunction &onDrop)
+{
+    if (m_hasCentre && x == m_centreX && z == m_centreZ) {
+        return;
+    }
+
+    m_hasCentre = true;
+    m_centreX = x;
+    m_centreZ = z;
+
+    m_chunks.eraseIf([&](Chunk &chunk) {
+        auto location = chunk.getLocation();
+        if (std::abs(location.x - x) <= m_radius &&
+            std::abs(location.y - z) <= m_radius) {
+            return false;
+        }
+
+        onDrop(chunk);
+        return true;
+    });
+}
+
+void HashedChunkStorage::forEach(const std::function<void(Chunk &)> &function)
+{
+    m_chunks.forEach(function);
+}
+
+std::size_t HashedChunkStorage::size() const noexcept
+{
+    return m_chunks.size();
+}
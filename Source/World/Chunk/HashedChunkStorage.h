@@ -0,0 +1,38 @@
+#ifndef HASHEDCHUNKSTORAGE_H_INCLUDED
+#define HASHEDCHUNKSTORAGE_H_INCLUDED
+
+#include "Chunk.h"
+#include "ChunkStorage.h"
+#include "FlatChunkMap.h"
+
+/**
+ * @class HashedChunkStorage
+ * @brief Chunk storage backed by a FlatChunkMap.
+ *
+ * @details
+ * Can hold a chunk at any coordinate. Moving the centre scans every stored
+ * chunk and erases those outside the radius, so this is only done when the
+ * centre actually changes chunk.
+ */
+class HashedChunkStorage : public ChunkStorage {
+  public:
+    HashedChunkStorage(int radius);
+
+    Chunk *find(int x, int z) noexcept override;
+    const Chunk *find(int x, int z) const noexcept override;
+    Chunk *findOrCreate(int x, int z, World &world) override;
+    void erase(int x, int z) override;
+    void setCentre(int x, int z, const DropFunction &onDrop) override;
+    void forEach(const std::function<void(Chunk &)> &function) override;
+    std::size_t size() const noexcept override;
+
+  private:
+    FlatChunkMap<Chunk> m_chunks;
+
+    int m_radius;
+    int m_centreX = 0;
+    int m_centreZ = 0;
+    bool m_hasCentre = false;
+};
+
+#endif // HASHEDCHUNKSTORAGE_H_INCLUDED
@@ -0,0 +1,40 @@
+#ifndef ICHUNKRENDERER_H_INCLUDED
+#define ICHUNKRENDERER_H_INCLUDED
+
+#include <memory>
+
+struct ChunkMeshCollection;
+
+/**
+ * @brief The GPU copy of a section's meshes.
+ *
+ * @details
+ * Created by an IChunkRenderer and held by the section until its meshes
+ * change or it is destroyed. Only the renderer knows what is inside, so the
+ * world code never touches GL; destroying a handle frees its buffers, and
+ * must happen on the thread the renderer draws on.
+ */
+struct IChunkMeshHandle {
+    virtual ~IChunkMeshHandle() = default;
+};
+
+/**
+ * @brief What the world needs from the renderer to draw chunks.
+ *
+ * @details
+ * Implemented by the renderer, which keeps the world free of GL so it can be
+ * built and run without a display.
+ */
+struct IChunkRenderer {
+    virtual ~IChunkRenderer() = default;
+
+    /// @brief Copies a section's meshes into GPU buffers owned by the
+    /// returned handle.
+    virtual std::unique_ptr<IChunkMeshHandle>
+    bufferMesh(const ChunkMeshCollection &meshes) = 0;
+
+    /// @brief Draws the meshes of a handle this renderer created.
+    virtual void drawChunk(const IChunkMeshHandle &meshes) = 0;
+};
+
+#endif // ICHUNKRENDERER_H_INCLUDED
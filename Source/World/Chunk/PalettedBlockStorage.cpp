@@ -0,0 +1,229 @@
+#include "PalettedBlockStorage.h"
+
+#include <bit>
+
+namespace {
+constexpr int WORD_BITS = 64;
+} // namespace
+
+PalettedBlockStorage::PalettedBlockStorage(Block_t fill)
+    : m_palette{{fill, static_cast<uint16_t>(CHUNK_VOLUME)}}
+    , m_paletteSize(1)
+{
+}
+
+Block_t PalettedBlockStorage::get(int index) const noexcept
+{
+    if (isUniform()) {
+        return m_palette[0].block;
+    }
+    return m_palette[getIndexAt(index)].block;
+}
+
+void PalettedBlockStorage::set(int index, Block_t block)
+{
+    int oldIndex = getIndexAt(index);
+    if (m_palette[oldIndex].block == block) {
+        return;
+    }
+
+    // Widening the indices keeps palette positions, so oldIndex stays valid
+    int newIndex = findOrAddPaletteEntry(block);
+    m_palette[newIndex].count++;
+    setIndexAt(index, newIndex);
+
+    if (--m_palette[oldIndex].count == 0) {
+        m_paletteSize--;
+        shrinkToFit();
+    }
+}
+
+void PalettedBlockStorage::fill(int first, int count, Block_t block)
+{
+    if (count == CHUNK_VOLUME) {
+        *this = PalettedBlockStorage(block);
+        return;
+    }
+    if (count <= 0 || (isUniform() && m_palette[0].block == block)) {
+        return;
+    }
+
+    int newIndex = findOrAddPaletteEntry(block);
+    bool isEntryFreed = false;
+
+    for (int index = first; index < first + count; index++) {
+        int oldIndex = getIndexAt(index);
+        if (oldIndex == newIndex) {
+            continue;
+        }
+
+        m_palette[newIndex].count++;
+        setIndexAt(index, newIndex);
+        if (--m_palette[oldIndex].count == 0) {
+            m_paletteSize--;
+            isEntryFreed = true;
+        }
+    }
+
+    if (isEntryFreed) {
+        shrinkToFit();
+    }
+}
+
+bool PalettedBlockStorage::isUniform() const noexcept
+{
+    return m_bitsPerIndex == 0;
+}
+
+Block_t PalettedBlockStorage::getUniformBlock() const noexcept
+{
+    return m_palette[0].block;
+}
+
+int PalettedBlockStorage::getBitsPerIndex() const noexcept
+{
+    return m_bitsPerIndex;
+}
+
+int PalettedBlockStorage::getPaletteSize() const noexcept
+{
+    return m_paletteSize;
+}
+
+std::size_t PalettedBlockStorage::getMemoryUsage() const noexcept
+{
+    return sizeof(*this) + m_palette.capacity() * sizeof(PaletteEntry) +
+           m_indices.capacity() * sizeof(uint64_t);
+}
+
+int PalettedBlockStorage::findOrAddPaletteEntry(Block_t block)
+{
+    int freeEntry = -1;
+    for (int i = 0; i < (int)m_palette.size(); i++) {
+        if (m_palette[i].count == 0) {
+            if (freeEntry == -1) {
+                freeEntry = i;
+            }
+        }
+        else if (m_palette[i].block == block) {
+            return i;
+        }
+    }
+
+    m_paletteSize++;
+    if (freeEntry != -1) {
+        m_palette[freeEntry].block = block;
+        return freeEntry;
+    }
+
+    if ((int)m_palette.size() == (1 << m_bitsPerIndex)) {
+        resize(isUniform() ? 1 : m_bitsPerIndex * 2);
+    }
+    m_palette.push_back({block, 0});
+    return (int)m_palette.size() - 1;
+}
+
+int PalettedBlockStorage::getIndexAt(int index) const noexcept
+{
+    if (isUniform()) {
+        return 0;
+    }
+
+    // Widths are powers of two, so the divisions reduce to shifts and masks
+    int shift = (index & (m_indicesPerWord - 1)) << m_bitsShift;
+    uint64_t word = m_indices[index >> m_indicesPerWordShift];
+
+    return static_cast<int>((word >> shift) & m_mask);
+}
+
+void PalettedBlockStorage::setIndexAt(int index, int paletteIndex) noexcept
+{
+    int shift = (index & (m_indicesPerWord - 1)) << m_bitsShift;
+    auto &word = m_indices[index >> m_indicesPerWordShift];
+
+    word = (word & ~(m_mask << shift)) |
+           (static_cast<uint64_t>(paletteIndex) << shift);
+}
+
+void PalettedBlockStorage::setBitsPerIndex(int bitsPerIndex)
+{
+    m_bitsPerIndex = bitsPerIndex;
+    if (bitsPerIndex == 0) {
+        m_indices.clear();
+        m_indices.shrink_to_fit();
+        return;
+    }
+
+    m_bitsShift = std::countr_zero(static_cast<unsigned>(bitsPerIndex));
+    m_indicesPerWord = WORD_BITS / bitsPerIndex;
+    m_indicesPerWordShift =
+        std::countr_zero(static_cast<unsigned>(m_indicesPerWord));
+    m_mask = (uint64_t{1} << bitsPerIndex) - 1;
+
+    m_indices.assign(CHUNK_VOLUME / m_indicesPerWord, 0);
+    m_indices.shrink_to_fit();
+}
+
+void PalettedBlockStorage::resize(int bitsPerIndex)
+{
+    std::vector<int> unpacked(CHUNK_VOLUME);
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        unpacked[i] = getIndexAt(i);
+    }
+
+    setBitsPerIndex(bitsPerIndex);
+
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        setIndexAt(i, unpacked[i]);
+    }
+}
+
+void PalettedBlockStorage::shrinkToFit()
+{
+    int bitsPerIndex = bitsFor(m_paletteSize);
+    if (bitsPerIndex >= m_bitsPerIndex) {
+        return;
+    }
+
+    // Compact the palette, remembering where each live entry moved to
+    std::vector<int> remap(m_palette.size(), 0);
+    std::vector<PaletteEntry> palette;
+    for (int i = 0; i < (int)m_palette.size(); i++) {
+        if (m_palette[i].count > 0) {
+            remap[i] = (int)palette.size();
+            palette.push_back(m_palette[i]);
+        }
+    }
+
+    std::vector<int> unpacked(CHUNK_VOLUME);
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        unpacked[i] = remap[getIndexAt(i)];
+    }
+
+    m_palette = std::move(palette);
+    setBitsPerIndex(bitsPerIndex);
+    if (isUniform()) {
+        return;
+    }
+
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        setIndexAt(i, unpacked[i]);
+    }
+}
+
+int PalettedBlockStorage::bitsFor(int paletteSize) noexcept
+{
+    if (paletteSize <= 1) {
+        return 0;
+    }
+    else if (paletteSize <= 2) {
+        return 1;
+    }
+    else if (paletteSize <= 4) {
+        return 2;
+    }
+    else if (paletteSize <= 16) {
+        return 4;
+    }
+    return 8;
+}
@@ -0,0 +1,114 @@
+#ifndef PALETTEDBLOCKSTORAGE_H_INCLUDED
+#define PALETTEDBLOCKSTORAGE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Block/BlockId.h"
+#include "../WorldConstants.h"
+
+/**
+ * @class PalettedBlockStorage
+ * @brief Compressed block storage for a single chunk section.
+ *
+ * @details
+ * Instead of storing one byte per block, the storage keeps a small palette of
+ * the block types present in the section and a bit-packed array of indices
+ * into that palette. The width of an index is always a power of two (1, 2, 4
+ * or 8 bits) so that no index ever straddles two 64 bit words.
+ *
+ * A section made of a single block type (all air, all stone, ...) uses a
+ * width of 0: it holds just the one block value and no index array at all,
+ * until the first differing write switches it to packed indices.
+ *
+ * The index width grows when a new block type no longer fits into the
+ * palette, and shrinks again once enough types have been removed that the
+ * remaining ones fit into a narrower width.
+ */
+class PalettedBlockStorage {
+  public:
+    /**
+     * @brief Creates a storage where every block is set to the given block.
+     *
+     * @param fill The block every position is initialised with.
+     */
+    PalettedBlockStorage(Block_t fill = static_cast<Block_t>(BlockId::Air));
+
+    /**
+     * @brief Gets the block at the given index.
+     *
+     * @param index The index of the block, in the range [0, CHUNK_VOLUME).
+     *
+     * @return The block stored at the index.
+     */
+    Block_t get(int index) const noexcept;
+
+    /**
+     * @brief Sets the block at the given index.
+     *
+     * @param index The index of the block, in the range [0, CHUNK_VOLUME).
+     * @param block The block to store.
+     *
+     * @details
+     * Adds the block to the palette if it is not yet part of it, widening the
+     * indices if required. If the previous block at the index was the last one
+     * of its type, its palette entry is released and the indices are narrowed
+     * if the remaining types allow it.
+     */
+    void set(int index, Block_t block);
+
+    /**
+     * @brief Sets the blocks in the range [first, first + count).
+     *
+     * @details
+     * Works like calling set for each index, but looks the block up in the
+     * palette only once and narrows the indices at most once, at the end.
+     * Filling the whole storage makes it uniform straight away.
+     */
+    void fill(int first, int count, Block_t block);
+
+    /// @brief Checks if every block in the storage is the same block.
+    bool isUniform() const noexcept;
+
+    /// @brief Gets the block filling a uniform storage.
+    Block_t getUniformBlock() const noexcept;
+
+    /// @brief Gets the number of bits used per block index.
+    int getBitsPerIndex() const noexcept;
+
+    /// @brief Gets the number of distinct block types currently stored.
+    int getPaletteSize() const noexcept;
+
+    /// @brief Gets the number of heap and inline bytes used by the storage.
+    std::size_t getMemoryUsage() const noexcept;
+
+  private:
+    struct PaletteEntry {
+        Block_t block;
+        uint16_t count;
+    };
+
+    int findOrAddPaletteEntry(Block_t block);
+    int getIndexAt(int index) const noexcept;
+    void setIndexAt(int index, int paletteIndex) noexcept;
+    void setBitsPerIndex(int bitsPerIndex);
+
+    void resize(int bitsPerIndex);
+    void shrinkToFit();
+
+    static int bitsFor(int paletteSize) noexcept;
+
+    std::vector<PaletteEntry> m_palette;
+    std::vector<uint64_t> m_indices;
+
+    int m_bitsPerIndex = 0;
+    int m_bitsShift = 0;
+    int m_indicesPerWord = 0;
+    int m_indicesPerWordShift = 0;
+    uint64_t m_mask = 0;
+
+    int m_paletteSize = 0;
+};
+
+#endif // PALETTEDBLOCKSTORAGE_H_INCLUDED
@@ -0,0 +1,149 @@
+#include "RingChunkStorage.h"
+
+#include <cstdlib>
+
+namespace {
+int wrap(int value, int width)
+{
+    int result = value % width;
+    return result < 0 ? result + width : result;
+}
+} // namespace
+
+RingChunkStorage::RingChunkStorage(int radius)
+    : m_slots((2 * radius + 1) * (2 * radius + 1))
+    , m_radius(radius)
+    , m_width(2 * radius + 1)
+{
+}
+
+Chunk *RingChunkStorage::find(int x, int z) noexcept
+{
+    if (!isInside(x, z)) {
+        return nullptr;
+    }
+
+    auto &slot = getSlot(x, z);
+    return slot ? &*slot : nullptr;
+}
+
+const Chunk *RingChunkStorage::find(int x, int z) const noexcept
+{
+    if (!isInside(x, z)) {
+        return nullptr;
+    }
+
+    auto &slot = getSlot(x, z);
+    return slot ? &*slot : nullptr;
+}
+
+Chunk *RingChunkStorage::findOrCreate(int x, int z, World &world)
+{
+    if (!isInside(x, z)) {
+        return nullptr;
+    }
+
+    auto &slot = getSlot(x, z);
+    if (!slot) {
+        slot.emplace(world, sf::Vector2i(x, z));
+        m_size++;
+        linkNeighbours(*slot);
+    }
+    return &*slot;
+}
+
+void RingChunkStorage::erase(int x, int z)
+{
+    if (isInside(x, z)) {
+        clearSlot(x, z, {});
+    }
+}
+
+void RingChunkStorage::setCentre(int x, int z, const DropFunction &onDrop)
+{
+    int dx = x - m_centreX;
+    int dz = z - m_centreZ;
+
+    if (std::abs(dx) >= m_width || std::abs(dz) >= m_width) {
+        for (auto &slot : m_slots) {
+            if (slot) {
+                onDrop(*slot);
+                slot.reset();
+            }
+        }
+        m_size = 0;
+    }
+    else {
+        // Columns that leave the square, then rows that leave it
+        for (int i = 0; i < std::abs(dx); i++) {
+            clearColumn(dx > 0 ? m_centreX - m_radius + i
+                               : m_centreX + m_radius - i,
+                        onDrop);
+        }
+        for (int i = 0; i < std::abs(dz); i++) {
+            clearRow(dz > 0 ? m_centreZ - m_radius + i
+                            : m_centreZ + m_radius - i,
+                     onDrop);
+        }
+    }
+
+    m_centreX = x;
+    m_centreZ = z;
+}
+
+void RingChunkStorage::forEach(const std::function<void(Chunk &)> &function)
+{
+    for (auto &slot : m_slots) {
+        if (slot) {
+            function(*slot);
+        }
+    }
+}
+
+std::size_t RingChunkStorage::size() const noexcept
+{
+    return m_size;
+}
+
+bool RingChunkStorage::isInside(int x, int z) const noexcept
+{
+    return std::abs(x - m_centreX) <= m_radius &&
+           std::abs(z - m_centreZ) <= m_radius;
+}
+
+std::optional<Chunk> &RingChunkStorage::getSlot(int x, int z) noexcept
+{
+    return m_slots[wrap(x, m_width) * m_width + wrap(z, m_width)];
+}
+
+const std::optional<Chunk> &RingChunkStorage::getSlot(int x,
+                                                      int z) const noexcept
+{
+    return m_slots[wrap(x, m_width) * m_width + wrap(z, m_width)];
+}
+
+void RingChunkStorage::clearColumn(int x, const DropFunction &onDrop)
+{
+    for (int z = m_centreZ - m_radius; z <= m_centreZ + m_radius; z++) {
+        clearSlot(x, z, onDrop);
+    }
+}
+
+void RingChunkStorage::clearRow(int z, const DropFunction &onDrop)
+{
+    for (int x = m_centreX - m_radius; x <= m_centreX + m_radius; x++) {
+        clearSlot(x, z, onDrop);
+    }
+}
+
+void RingChunkStorage::clearSlot(int x, int z, const DropFunction &onDrop)
+{
+    auto &slot = getSlot(x, z);
+    if (slot) {
+        if (onDrop) {
+            onDrop(*slot);
+        }
+        slot.reset();
+        m_size--;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef RINGCHUNKSTORAGE_H_INCLUDED
+#define RINGCHUNKSTORAGE_H_INCLUDED
+
+#include <optional>
+#include <vector>
+
+#include "Chunk.h"
+#include "ChunkStorage.h"
+
+/**
+ * @class RingChunkStorage
+ * @brief Chunk storage backed by a fixed, toroidal grid centred on the player.
+ *
+ * @details
+ * The grid holds (2 * radius + 1)^2 chunk slots. The chunk at (x, z) always
+ * lives in slot (x mod N, z mod N), so finding a chunk is a bounds check and
+ * an index calculation, with no hashing involved.
+ *
+ * Chunks outside the square around the centre cannot be stored. When the
+ * centre moves, only the columns and rows of slots that scroll out of the
+ * square are cleared; everything else stays where it is.
+ */
+class RingChunkStorage : public ChunkStorage {
+  public:
+    RingChunkStorage(int radius);
+
+    Chunk *find(int x, int z) noexcept override;
+    const Chunk *find(int x, int z) const noexcept override;
+    Chunk *findOrCreate(int x, int z, World &world) override;
+    void erase(int x, int z) override;
+    void setCentre(int x, int z, const DropFunction &onDrop) override;
+    void forEach(const std::function<void(Chunk &)> &function) override;
+    std::size_t size() const noexcept override;
+
+  private:
+    bool isInside(int x, int z) const noexcept;
+    std::optional<Chunk> &getSlot(int x, int z) noexcept;
+    const std::optional<Chunk> &getSlot(int x, int z) const noexcept;
+
+    void clearColumn(int x, const DropFunction &onDrop);
+    void clearRow(int z, const DropFunction &onDrop);
+    void clearSlot(int x, int z, const DropFunction &onDrop);
+
+    std::vector<std::optional<Chunk>> m_slots;
+
+    int m_radius;
+    int m_width;
+    int m_centreX = 0;
+    int m_centreZ = 0;
+    std::size_t m_size = 0;
+};
+
+#endif // RINGCHUNKSTORAGE_H_INCLUDED
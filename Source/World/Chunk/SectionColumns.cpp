@@ -0,0 +1,103 @@
+#include "SectionColumns.h"
+
+#include <bit>
+
+namespace {
+constexpr uint32_t CELLS = (1u << CHUNK_SIZE) - 1;
+constexpr int BORDER = CHUNK_SIZE + 1;
+constexpr int WORDS_PER_LAYER = CHUNK_AREA / 64;
+constexpr int ROWS_PER_WORD = 64 / CHUNK_SIZE;
+} // namespace
+
+void SectionColumns::build(const BlockMask &opaque, const BlockMask &nonAir,
+                           const FaceMasks &opaqueFaces,
+                           const FaceMasks &nonAirFaces)
+{
+    buildColumns(m_opaque, opaque, opaqueFaces);
+    buildColumns(m_nonAir, nonAir, nonAirFaces);
+}
+
+SectionColumns::Faces SectionColumns::getFaces(Direction direction,
+                                               int column) const noexcept
+{
+    int axis = direction / 2;
+    uint32_t opaque = m_opaque[axis][column];
+    uint32_t nonAir = m_nonAir[axis][column];
+
+    // Line each cell up with its neighbour in the direction of the face
+    int shift = (direction & 1) ? 2 : 0;
+    uint32_t cells = (nonAir >> 1) & CELLS;
+    uint32_t adjacentOpaque = (opaque >> shift) & CELLS;
+    uint32_t adjacentNonAir = (nonAir >> shift) & CELLS;
+
+    uint32_t faces = cells & ~adjacentOpaque;
+    return {static_cast<uint16_t>(faces & ~adjacentNonAir),
+            static_cast<uint16_t>(faces & adjacentNonAir)};
+}
+
+void SectionColumns::getPosition(Direction direction, int column, int i,
+                                 int &x, int &y, int &z) noexcept
+{
+    int high = column / CHUNK_SIZE;
+    int low = column % CHUNK_SIZE;
+
+    switch (direction / 2) {
+        case 0:
+            x = i, y = high, z = low;
+            break;
+
+        case 1:
+            x = low, y = i, z = high;
+            break;
+
+        default:
+            x = low, y = high, z = i;
+            break;
+    }
+}
+
+void SectionColumns::buildColumns(Columns &columns, const BlockMask &cells,
+                                  const FaceMasks &faces)
+{
+    for (auto &axis : columns) {
+        axis.fill(0);
+    }
+
+    auto &alongX = columns[0];
+    auto &alongY = columns[1];
+    auto &alongZ = columns[2];
+
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            uint64_t word =
+                cells.getWord(y * WORDS_PER_LAYER + z / ROWS_PER_WORD);
+            uint32_t row =
+                (word >> ((z % ROWS_PER_WORD) * CHUNK_SIZE)) & CELLS;
+
+            alongX[y * CHUNK_SIZE + z] = row << 1;
+
+            // Rows along x become one bit in each of the y and z columns
+            for (; row != 0; row &= row - 1) {
+                int x = std::countr_zero(row);
+                alongY[z * CHUNK_SIZE + x] |= 1u << (y + 1);
+                alongZ[y * CHUNK_SIZE + x] |= 1u << (z + 1);
+            }
+        }
+    }
+
+    for (int direction = 0; direction < 6; direction++) {
+        const FaceMask *face = faces[direction];
+        if (!face) {
+            continue;
+        }
+
+        auto &axis = columns[direction / 2];
+        uint32_t bit = (direction & 1) ? 1u << BORDER : 1u;
+        for (int w = 0; w < FaceMask::NUM_WORDS; w++) {
+            for (uint64_t word = face->getWord(w); word != 0;
+                 word &= word - 1) {
+                axis[w * 64 + std::countr_zero(word)] |= bit;
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef SECTIONCOLUMNS_H_INCLUDED
+#define SECTIONCOLUMNS_H_INCLUDED
+
+#include <array>
+#include <cstdint>
+
+#include "../../Util/BitMask.h"
+#include "../WorldConstants.h"
+
+/**
+ * @class SectionColumns
+ * @brief Finds the visible faces of a section with bit operations on columns.
+ *
+ * @details
+ * The opaque and non-air masks of a section are rearranged into columns of
+ * cells along each axis. Bit i + 1 of a column is the cell at i along the
+ * axis; bits 0 and CHUNK_SIZE + 1 are the cells just outside the section,
+ * taken from the neighbours' face masks. Shifting a column by one cell lines
+ * every cell up with its neighbour, so the faces of a whole column are found
+ * with a shift and an AND-NOT.
+ *
+ * Columns are indexed like the face masks of ChunkSection: (y, z) along X,
+ * (z, x) along Y and (y, x) along Z.
+ */
+class SectionColumns {
+  public:
+    using BlockMask = BitMask<CHUNK_VOLUME>;
+    using FaceMask = BitMask<CHUNK_AREA>;
+    using FaceMasks = std::array<const FaceMask *, 6>;
+
+    /// @brief Face directions, in the same order as ChunkSection::Neighbour.
+    enum Direction { NegX, PosX, NegY, PosY, NegZ, PosZ };
+
+    /// @brief The faces of one column pointing in one direction, one bit per cell.
+    struct Faces {
+        /// Faces against air, which are always visible.
+        uint16_t open;
+        /// Faces against a non-opaque block, visible unless both blocks are
+        /// of the same type.
+        uint16_t transparent;
+    };
+
+    /**
+     * @brief Builds the columns of a section.
+     *
+     * @param opaque       The section's opaque cells.
+     * @param nonAir       The section's non-air cells.
+     * @param opaqueFaces  Per direction, the opaque cells of the neighbour's
+     *                     face touching the section, or nullptr if the
+     *                     neighbour is air.
+     * @param nonAirFaces  The same for the neighbours' non-air cells.
+     */
+    void build(const BlockMask &opaque, const BlockMask &nonAir,
+               const FaceMasks &opaqueFaces, const FaceMasks &nonAirFaces);
+
+    Faces getFaces(Direction direction, int column) const noexcept;
+
+    /// @brief Gets the position of bit i of a column along a direction's axis.
+    static void getPosition(Direction direction, int column, int i, int &x,
+                            int &y, int &z) noexcept;
+
+  private:
+    using Columns = std::array<std::array<uint32_t, CHUNK_AREA>, 3>;
+
+    static void buildColumns(Columns &columns, const BlockMask &cells,
+                             const FaceMasks &faces);
+
+    Columns m_opaque;
+    Columns m_nonAir;
+};
+
+#endif // SECTIONCOLUMNS_H_INCLUDED
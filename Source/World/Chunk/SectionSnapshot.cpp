@@ -0,0 +1,162 @@
+#include "SectionSnapshot.h"
+
+#include "ChunkSection.h"
+
+#include <algorithm>
+
+namespace {
+constexpr Block_t AIR = static_cast<Block_t>(BlockId::Air);
+
+// Finds the section at an offset of up to one in each axis by walking the
+// neighbour links. A section that does not exist has no links, so every
+// order of the axes is tried before giving up on a diagonal.
+const ChunkSection *findSection(const ChunkSection &section, int dx, int dy,
+                                int dz)
+{
+    const int offset[3] = {dx, dy, dz};
+    std::array<int, 3> axes{0, 1, 2};
+
+    do {
+        const ChunkSection *current = &section;
+        for (int axis : axes) {
+            if (offset[axis] != 0 && current) {
+                auto direction = static_cast<ChunkSection::Neighbour>(
+                    axis * 2 + (offset[axis] > 0));
+                current = current->getNeighbour(direction);
+            }
+        }
+
+        if (current) {
+            return current;
+        }
+    } while (std::next_permutation(axes.begin(), axes.end()));
+
+    return nullptr;
+}
+} // namespace
+
+void SectionSnapshot::capture(const ChunkSection &section)
+{
+    m_location = section.getLocation();
+    m_isUniform = section.isUniform();
+    m_uniformBlock = section.getUniformBlock().id;
+    m_opaqueMask = section.getOpaqueMask();
+    m_nonAirMask = section.getNonAirMask();
+
+    for (int i = 0; i < ChunkSection::NUM_NEIGHBOURS; i++) {
+        auto direction = static_cast<ChunkSection::Neighbour>(i);
+        auto opposite = static_cast<ChunkSection::Neighbour>(i ^ 1);
+
+        const ChunkSection *adjacent = section.getNeighbour(direction);
+        m_opaqueFaces[i] =
+            adjacent ? adjacent->getOpaqueFace(opposite) : FaceMask{};
+        m_nonAirFaces[i] =
+            adjacent ? adjacent->getNonAirFace(opposite) : FaceMask{};
+    }
+
+    for (int y = 0; y < CHUNK_SIZE; y++)
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            Block_t *row = &m_blocks[getPaddedIndex(0, y, z)];
+            if (m_isUniform) {
+                std::fill_n(row, CHUNK_SIZE, m_uniformBlock);
+                continue;
+            }
+
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                row[x] = section.getBlock(x, y, z).id;
+            }
+        }
+
+    for (int dy = -1; dy <= 1; dy++)
+        for (int dz = -1; dz <= 1; dz++)
+            for (int dx = -1; dx <= 1; dx++) {
+                if (dx != 0 || dy != 0 || dz != 0) {
+                    captureBorder(section, dx, dy, dz);
+                }
+            }
+}
+
+// Copies the part of the border shared with the section at an offset
+void SectionSnapshot::captureBorder(const ChunkSection &section, int dx,
+                                    int dy, int dz)
+{
+    // Along each axis the border is either the single layer next to the
+    // section or, where the offset is 0, the full width of the section
+    auto first = [](int offset) {
+        return offset < 0 ? -1 : offset * CHUNK_SIZE;
+    };
+    auto last = [](int offset) {
+        return offset < 0 ? -1 : offset > 0 ? CHUNK_SIZE : CHUNK_SIZE - 1;
+    };
+
+    const ChunkSection *adjacent = findSection(section, dx, dy, dz);
+
+    for (int y = first(dy); y <= last(dy); y++)
+        for (int z = first(dz); z <= last(dz); z++)
+            for (int x = first(dx); x <= last(dx); x++) {
+                Block_t &block = m_blocks[getPaddedIndex(x, y, z)];
+                if (!adjacent) {
+                    block = AIR;
+                    continue;
+                }
+
+                block = adjacent
+                            ->getBlock(x - dx * CHUNK_SIZE, y - dy * CHUNK_SIZE,
+                                       z - dz * CHUNK_SIZE)
+                            .id;
+            }
+}
+
+const sf::Vector3i &SectionSnapshot::getLocation() const noexcept
+{
+    return m_location;
+}
+
+bool SectionSnapshot::isUniform() const noexcept
+{
+    return m_isUniform;
+}
+
+ChunkBlock SectionSnapshot::getUniformBlock() const noexcept
+{
+    return m_uniformBlock;
+}
+
+bool SectionSnapshot::isLayerOpaque(int y) const noexcept
+{
+    constexpr int WORDS_PER_LAYER = CHUNK_AREA / 64;
+
+    // The layers just outside the section are the faces of the sections above
+    // and below
+    if (y == -1) {
+        return m_opaqueFaces[ChunkSection::NegY].all();
+    }
+    if (y == CHUNK_SIZE) {
+        return m_opaqueFaces[ChunkSection::PosY].all();
+    }
+    return m_opaqueMask.allWords(y * WORDS_PER_LAYER, WORDS_PER_LAYER);
+}
+
+const SectionSnapshot::BlockMask &
+SectionSnapshot::getOpaqueMask() const noexcept
+{
+    return m_opaqueMask;
+}
+
+const SectionSnapshot::BlockMask &
+SectionSnapshot::getNonAirMask() const noexcept
+{
+    return m_nonAirMask;
+}
+
+const SectionSnapshot::FaceMask &
+SectionSnapshot::getOpaqueFace(int direction) const noexcept
+{
+    return m_opaqueFaces[direction];
+}
+
+const SectionSnapshot::FaceMask &
+SectionSnapshot::getNonAirFace(int direction) const noexcept
+{
+    return m_nonAirFaces[direction];
+}
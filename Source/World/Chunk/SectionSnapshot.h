@@ -0,0 +1,90 @@
+#ifndef SECTIONSNAPSHOT_H_INCLUDED
+#define SECTIONSNAPSHOT_H_INCLUDED
+
+#include <SFML/System/Vector3.hpp>
+#include <array>
+
+#include "../../Util/BitMask.h"
+#include "../Block/ChunkBlock.h"
+#include "../WorldConstants.h"
+
+class ChunkSection;
+
+/**
+ * @class SectionSnapshot
+ * @brief A copy of a section and the blocks around it, taken before meshing.
+ *
+ * @details
+ * Holds the blocks of the section plus a one block border from the 26
+ * surrounding sections in one contiguous (CHUNK_SIZE + 2)^3 array, together
+ * with the section's bit masks and the face masks of its neighbours. Once
+ * captured, a mesh can be built from the snapshot alone, without reading the
+ * section, its neighbours or the world again.
+ *
+ * Sections that do not exist, or whose chunk is not loaded, read as air.
+ */
+class SectionSnapshot {
+  public:
+    static constexpr int SIZE = CHUNK_SIZE + 2;
+
+    using BlockMask = BitMask<CHUNK_VOLUME>;
+    using FaceMask = BitMask<CHUNK_AREA>;
+
+    /// @brief Copies the section and the border around it.
+    void capture(const ChunkSection &section);
+
+    /**
+     * @brief Gets a block of the section or its border.
+     *
+     * @details
+     * Every coordinate must be in the range [-1, CHUNK_SIZE].
+     */
+    ChunkBlock getBlock(int x, int y, int z) const noexcept
+    {
+        return m_blocks[getPaddedIndex(x, y, z)];
+    }
+
+    const sf::Vector3i &getLocation() const noexcept;
+
+    bool isUniform() const noexcept;
+    ChunkBlock getUniformBlock() const noexcept;
+
+    /// @brief Checks if every block in a layer in the range [-1, CHUNK_SIZE] is opaque.
+    bool isLayerOpaque(int y) const noexcept;
+
+    const BlockMask &getOpaqueMask() const noexcept;
+    const BlockMask &getNonAirMask() const noexcept;
+
+    /**
+     * @brief Gets the opaque cells of the neighbour's face touching the
+     * section in the given direction.
+     *
+     * @param direction A ChunkSection::Neighbour. A missing neighbour has an
+     *                  empty mask.
+     */
+    const FaceMask &getOpaqueFace(int direction) const noexcept;
+
+    /// @brief Gets the non-air cells of the neighbour's face touching the section.
+    const FaceMask &getNonAirFace(int direction) const noexcept;
+
+  private:
+    static int getPaddedIndex(int x, int y, int z) noexcept
+    {
+        return ((y + 1) * SIZE + (z + 1)) * SIZE + (x + 1);
+    }
+
+    void captureBorder(const ChunkSection &section, int dx, int dy, int dz);
+
+    std::array<Block_t, SIZE * SIZE * SIZE> m_blocks;
+
+    BlockMask m_opaqueMask;
+    BlockMask m_nonAirMask;
+    std::array<FaceMask, 6> m_opaqueFaces;
+    std::array<FaceMask, 6> m_nonAirFaces;
+
+    sf::Vector3i m_location;
+    Block_t m_uniformBlock = 0;
+    bool m_isUniform = false;
+};
+
+#endif // SECTIONSNAPSHOT_H_INCLUDED
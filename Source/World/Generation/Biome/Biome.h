@@ -2,10 +2,10 @@
 #define BIOME_H_INCLUDED
 
 #include "../../../Maths/NoiseGenerator.h"
-#include "../../../Util/Random.h"
+#include "../../../Util/PositionRandom.h"
 #include "../../Block/ChunkBlock.h"
 
-using Rand = Random<std::minstd_rand>;
+using Rand = PositionRandom::Stream;
 
 class Chunk;
 
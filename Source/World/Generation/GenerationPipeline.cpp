@@ -0,0 +1,185 @@
+#include "GenerationPipeline.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <SFML/System/Clock.hpp>
+
+#include "../../Util/ThreadPool.h"
+#include "../Chunk/Chunk.h"
+#include "../WorldConstants.h"
+#include "Terrain/TerrainGenerator.h"
+
+namespace {
+// The part of a column that holds terrain, ranking columns mostly by their
+// horizontal distance from the camera
+AABB getColumnBounds(int x, int z)
+{
+    AABB bounds({CHUNK_SIZE, WATER_LEVEL * 2, CHUNK_SIZE});
+    bounds.update({x * CHUNK_SIZE, 0, z * CHUNK_SIZE});
+    return bounds;
+}
+} // namespace
+
+GenerationPipeline::GenerationPipeline(World &world, const TerrainGenerator &generator,
+                                       int threadCount)
+    : m_world(&world)
+    , m_generator(&generator)
+    , m_workers(threadCount > 0 ? threadCount : ThreadPool::getDefaultThreadCount())
+{
+}
+
+GenerationPipeline::GenerationPipeline(const TerrainGenerator &generator, int threadCount)
+    : m_world(nullptr)
+    , m_generator(&generator)
+    , m_workers(threadCount > 0 ? threadCount : ThreadPool::getDefaultThreadCount())
+{
+}
+
+GenerationPipeline::~GenerationPipeline()
+{
+    // Stages still running finish without starting any more
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isRunning = false;
+}
+
+void GenerationPipeline::request(int x, int z)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    advance(getJob(x, z, ChunkStatus::Decorated));
+}
+
+std::vector<std::unique_ptr<Chunk>> GenerationPipeline::takeFinished()
+{
+    std::vector<std::unique_ptr<Chunk>> finished;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobs.forEach([&](Job &job) {
+        if (job.status == ChunkStatus::Decorated && !job.isRunning) {
+            finished.push_back(std::move(job.chunk));
+
+            // Only the layout is left for the neighbours; if the chunk is
+            // requested again, its blocks are written into a new chunk
+            job.status = ChunkStatus::Heights;
+            job.target = ChunkStatus::Heights;
+        }
+    });
+    return finished;
+}
+
+void GenerationPipeline::setCentre(int x, int z, int radius)
+{
+    auto getDistance = [&](const Job &job) {
+        return std::max(std::abs(job.x - x), std::abs(job.z - z));
+    };
+
+    // The ring just outside is kept, as the chunks at the edge wait on it;
+    // dropping it would only have its stages run again by the next advance.
+    // It is generated no further than those chunks need.
+    ChunkStatus neighbourStage = m_generator->getNeighbourStage(ChunkStatus::Decorated);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobs.forEach([&](Job &job) {
+        if (getDistance(job) > radius && job.target > neighbourStage) {
+            job.target = neighbourStage;
+        }
+    });
+    m_jobs.eraseIf([&](const Job &job) {
+        return !job.isRunning && getDistance(job) > radius + 1;
+    });
+}
+
+void GenerationPipeline::setFocus(const glm::vec3 &position,
+                                  const ViewFrustum &frustum, int radius)
+{
+    m_workers.setFocus(position, frustum, radius + 1);
+}
+
+GenerationPipeline::Statistics GenerationPipeline::takeStatistics()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Statistics taken = m_statistics;
+    taken.jobs = m_workers.takeStatistics();
+    m_statistics = {};
+    return taken;
+}
+
+GenerationPipeline::Job &GenerationPipeline::getJob(int x, int z, ChunkStatus target)
+{
+    auto [job, isNew] = m_jobs.tryEmplace(x, z, Job{x, z});
+    if (job->target < target) {
+        job->target = target;
+    }
+    return *job;
+}
+
+void GenerationPipeline::advance(Job &job)
+{
+    if (!m_isRunning || job.isRunning || job.status >= job.target) {
+        return;
+    }
+
+    ChunkStatus stage = nextStatus(job.status);
+    ChunkStatus neighbourStage = m_generator->getNeighbourStage(stage);
+    if (neighbourStage != ChunkStatus::Empty) {
+        bool isReady = true;
+        for (int dx = -1; dx <= 1; dx++)
+            for (int dz = -1; dz <= 1; dz++) {
+                if (dx == 0 && dz == 0) {
+                    continue;
+                }
+
+                // The neighbour stage comes before this one, so this never
+                // leads back here
+                Job &neighbour = getJob(job.x + dx, job.z + dz, neighbourStage);
+                if (neighbour.status < neighbourStage) {
+                    advance(neighbour);
+                    isReady = false;
+                }
+            }
+        if (!isReady) {
+            return;
+        }
+    }
+
+    if (!job.chunk) {
+        sf::Vector2i location(job.x, job.z);
+        job.chunk = m_world ? std::make_unique<Chunk>(*m_world, location)
+                            : std::make_unique<Chunk>(location);
+    }
+
+    // Jobs are never erased while running, and the map never moves them
+    job.isRunning = true;
+    m_workers.push(
+        getColumnBounds(job.x, job.z),
+        [this, &job, stage] {
+            sf::Clock timer;
+            job.chunk->generateStage(*m_generator, stage);
+            float seconds = timer.getElapsedTime().asSeconds();
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            int index = static_cast<int>(stage) - 1;
+            m_statistics.stages[index]++;
+            m_statistics.stageSeconds[index] += seconds;
+            finishStage(job);
+        },
+        [this, &job] {
+            // Left where it was, for setCentre to drop or a request to resume
+            std::unique_lock<std::mutex> lock(m_mutex);
+            job.isRunning = false;
+        });
+}
+
+void GenerationPipeline::finishStage(Job &job)
+{
+    job.status = nextStatus(job.status);
+    job.isRunning = false;
+
+    // This may have been the last stage the job or its neighbours waited for
+    for (int dx = -1; dx <= 1; dx++)
+        for (int dz = -1; dz <= 1; dz++) {
+            if (Job *neighbour = m_jobs.find(job.x + dx, job.z + dz)) {
+                advance(*neighbour);
+            }
+        }
+}
@@ -0,0 +1,119 @@
+#ifndef GENERATIONPIPELINE_H_INCLUDED
+#define GENERATIONPIPELINE_H_INCLUDED
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../Util/NonCopyable.h"
+#include "../Chunk/ChunkJobScheduler.h"
+#include "../Chunk/ChunkStatus.h"
+#include "../Chunk/FlatChunkMap.h"
+
+class Chunk;
+class TerrainGenerator;
+class World;
+
+/**
+ * @class GenerationPipeline
+ * @brief Generates requested chunks one stage at a time on its own workers.
+ *
+ * @details
+ * Each generation stage of a chunk runs as a separate job. A stage is
+ * started once the chunk has finished the stage before it and its eight
+ * neighbours have reached the stage the generator asks for with
+ * TerrainGenerator::getNeighbourStage. Neighbours that are needed are
+ * brought up to that stage too, without being generated any further, so a
+ * chunk is never held back waiting for a whole 3x3 area to be generated.
+ *
+ * Chunks are generated detached, neither stored nor linked, and collected
+ * with takeFinished once decorated. Everything here is guarded by its own
+ * mutex, so requests do not need the world lock.
+ *
+ * Stages are queued on a ChunkJobScheduler, so with a focus set the chunks
+ * nearest the camera are generated first, and stages that have not started
+ * when the camera leaves them behind are dropped until requested again.
+ */
+class GenerationPipeline : public NonCopyable {
+  public:
+    /// @brief The generation stages, Biomes to Decorated.
+    static constexpr int NUM_STAGES = static_cast<int>(ChunkStatus::Decorated);
+
+    /// @brief Totals over every stage run since they were last taken,
+    /// indexed by stage, from Biomes at 0.
+    struct Statistics {
+        std::array<int, NUM_STAGES> stages{};
+        std::array<float, NUM_STAGES> stageSeconds{};
+        ChunkJobScheduler::Statistics jobs;
+    };
+
+    /// @param threadCount The number of workers, or 0 to leave one hardware
+    ///                    thread free and use the rest.
+    GenerationPipeline(World &world, const TerrainGenerator &generator,
+                       int threadCount);
+
+    /// @brief Creates a pipeline generating chunks outside of any world, for
+    /// tools that only need the terrain.
+    GenerationPipeline(const TerrainGenerator &generator, int threadCount);
+    ~GenerationPipeline();
+
+    /// @brief Asks for the chunk at the given position to be decorated.
+    void request(int x, int z);
+
+    /// @brief Takes the chunks decorated since the last call.
+    std::vector<std::unique_ptr<Chunk>> takeFinished();
+
+    /**
+     * @brief Drops the chunks further than the radius from the centre.
+     *
+     * @details
+     * The radius is that of the requested chunks. The ring of chunks just
+     * outside it is kept, but only generated as far as the chunks at the
+     * edge need their neighbours. Chunks with a stage running are kept until
+     * it finishes.
+     */
+    void setCentre(int x, int z, int radius);
+
+    /**
+     * @brief Reorders the stages waiting to start around the camera.
+     *
+     * @details
+     * Waiting stages of chunks further than the radius are cancelled, with
+     * the radius widened by the ring of neighbours as in setCentre.
+     */
+    void setFocus(const glm::vec3 &position, const ViewFrustum &frustum,
+                  int radius);
+
+    /// @brief Returns the statistics gathered so far and resets them.
+    Statistics takeStatistics();
+
+  private:
+    struct Job {
+        int x;
+        int z;
+        std::unique_ptr<Chunk> chunk = nullptr; // Created when a stage starts
+        ChunkStatus status = ChunkStatus::Empty;
+        ChunkStatus target = ChunkStatus::Empty;
+        bool isRunning = false; // Queued or running
+    };
+
+    Job &getJob(int x, int z, ChunkStatus target);
+
+    // Starts the next stage of the job if it and its neighbours are ready
+    void advance(Job &job);
+    void finishStage(Job &job);
+
+    World *m_world; // nullptr when generating outside of any world
+    const TerrainGenerator *m_generator;
+
+    FlatChunkMap<Job> m_jobs;
+    Statistics m_statistics;
+    bool m_isRunning = true;
+    std::mutex m_mutex;
+
+    // Declared last so the workers stop before anything they use is destroyed
+    ChunkJobScheduler m_workers;
+};
+
+#endif // GENERATIONPIPELINE_H_INCLUDED
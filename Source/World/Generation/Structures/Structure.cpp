@@ -52,7 +52,7 @@ Structure::Structure(const Structure& other)
     this->dimZ = other.dimZ;
 }
 
-void Structure::generate_structure(Chunk* chunk, sf::Vector3i center) {
+void Structure::generate_structure(Chunk* chunk, sf::Vector3i center) const {
     int x_offset = -dimX/2;
     int z_offset = -dimZ/2;
 
@@ -60,15 +60,22 @@ void Structure::generate_structure(Chunk* chunk, sf::Vector3i center) {
 
     for(int y = 0; y < dimY; y++) {
         for(int z = 0; z < dimZ; z++) {
-            for(int x = 0; x < dimX; x++) {
+            // Runs of the same block along x are written in one go
+            for(int x = 0; x < dimX;) {
                 int index = y * (dimX*dimZ) + z * dimX + x;
-                sf::Vector3i position(x, y, z);
-                position += center + offset;
+                int length = 1;
+                while(x + length < dimX && layers[index + length] == layers[index])
+                    length++;
 
-                if(layers[index] == 255) 
-                    continue;
+                if(layers[index] != 255) {
+                    sf::Vector3i position(x, y, z);
+                    position += center + offset;
 
-                chunk->setBlock(position.x, position.y, position.z, layers[index]);
+                    chunk->fillBox(position.x, position.y, position.z,
+                                   position.x + length, position.y + 1, position.z + 1,
+                                   layers[index]);
+                }
+                x += length;
             }
         }
     }
@@ -10,7 +10,7 @@ class Structure {
     public:
         Structure(const Structure& other);
         Structure(std::string file_name);
-        void generate_structure(Chunk* chunk, sf::Vector3i center);
+        void generate_structure(Chunk* chunk, sf::Vector3i center) const;
         void print_info();
         inline int get_id() {
             return id;
@@ -6,7 +6,7 @@
 constexpr BlockId CACTUS = BlockId::Cactus;
 
 namespace {
-void makeCactus1(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makeCactus1(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                  int z)
 {
     StructureBuilder builder;
@@ -14,7 +14,7 @@ void makeCactus1(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
     builder.build(chunk);
 }
 
-void makeCactus2(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makeCactus2(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                  int z)
 {
     StructureBuilder builder;
@@ -32,7 +32,7 @@ void makeCactus2(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
     builder.build(chunk);
 }
 
-void makeCactus3(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makeCactus3(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                  int z)
 {
     StructureBuilder builder;
@@ -51,7 +51,7 @@ void makeCactus3(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
 }
 } // namespace
 
-void makeOakTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makeOakTree(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                  int z)
 {
     StructureBuilder builder;
@@ -78,7 +78,7 @@ void makeOakTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
     builder.build(chunk);
 }
 
-void makePalmTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makePalmTree(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                   int z)
 {
     StructureBuilder builder;
@@ -106,7 +106,7 @@ void makePalmTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
     builder.build(chunk);
 }
 
-void makeCactus(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y,
+void makeCactus(Chunk &chunk, PositionRandom::Stream &rand, int x, int y,
                 int z)
 {
     int cac = rand.intInRange(0, 2);
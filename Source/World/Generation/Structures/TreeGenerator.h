@@ -1,7 +1,7 @@
 #ifndef TREEGENERATOR_H_INCLUDED
 #define TREEGENERATOR_H_INCLUDED
 
-#include "../../../Util/Random.h"
+#include "../../../Util/PositionRandom.h"
 
 class Chunk;
 
@@ -18,7 +18,7 @@ class Chunk;
  * @details
  * This function generates a tree in the specified chunk at the given coordinates.  
  */
-void makeOakTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y, int z);
+void makeOakTree(Chunk &chunk, PositionRandom::Stream &rand, int x, int y, int z);
 /**
  * @brief Generates a palm tree in the specified chunk at the given coordinates.
  * 
@@ -31,7 +31,7 @@ void makeOakTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y, int
  * @details
  * This function generates a palm tree in the specified chunk at the given coordinates.
  */
-void makePalmTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y, int z);
+void makePalmTree(Chunk &chunk, PositionRandom::Stream &rand, int x, int y, int z);
 /**
  * @brief Generates a cactus in the specified chunk at the given coordinates.
  * 
@@ -45,6 +45,6 @@ void makePalmTree(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y, in
  * This function generates a cactus in the specified chunk at the given coordinates.
  * The cactus is generated with a random height and may have additional branches.
  */
-void makeCactus(Chunk &chunk, Random<std::minstd_rand> &rand, int x, int y, int z);
+void makeCactus(Chunk &chunk, PositionRandom::Stream &rand, int x, int y, int z);
 
 #endif // TREEGENERATOR_H_INCLUDED
@@ -1,8 +1,10 @@
 #include "ClassicOverWorldGenerator.h"
 
+#include <array>
 #include <functional>
 #include <iostream>
 #include <filesystem>
+#include <mutex>
 #include <utility>
 
 #include "../../../Maths/GeneralMaths.h"
@@ -12,25 +14,34 @@
 #include "../Structures/TreeGenerator.h"
 #include "../Structures/Structure.h"
 
+using Purpose = PositionRandom::Purpose;
+
 namespace {
-const int seed = RandomSingleton::get().intInRange(424, 325322);
-}
+// Enough for the 3x3 areas around every chunk of a large render distance
+constexpr std::size_t TERRAIN_CACHE_CHUNKS = 4096;
 
-constexpr int chunk_seed(int chunkX, int chunkZ) {
-    return (chunkX ^ chunkZ) << 2;
+std::mutex statisticsMutex;
+ClassicOverWorldGenerator::Statistics statistics;
 }
 
-NoiseGenerator ClassicOverWorldGenerator::m_biomeNoiseGen(seed * 2);
-
 ClassicOverWorldGenerator::ClassicOverWorldGenerator()
-    : m_grassBiome(seed)
+    : ClassicOverWorldGenerator(RandomSingleton::get().intInRange(424, 325322))
+{
+}
+
+ClassicOverWorldGenerator::ClassicOverWorldGenerator(int seed)
+    : m_seed(seed)
+    , m_biomeNoiseGen(seed * 2)
+    , m_grassBiome(seed)
     , m_temperateForest(seed)
     , m_desertBiome(seed)
     , m_oceanBiome(seed)
     , m_lightForest(seed)
+    , m_random(seed)
+    , m_biomeCache(TERRAIN_CACHE_CHUNKS)
+    , m_heightCache(TERRAIN_CACHE_CHUNKS)
 {
     setUpNoise();
-    m_heightMap.setAll(0);
 
     std::filesystem::directory_iterator struct_it("Res/Structures/");
 
@@ -49,37 +60,54 @@ ClassicOverWorldGenerator::ClassicOverWorldGenerator()
 
 void ClassicOverWorldGenerator::setUpNoise()
 {
-    std::cout << "Seed: " << seed << '\n';
-    static bool noiseGen = false;
-    if (!noiseGen) {
-        std::cout << "making noise\n";
-        noiseGen = true;
-
-        NoiseParameters biomeParmams;
-        biomeParmams.octaves = 5;
-        biomeParmams.amplitude = 120;
-        biomeParmams.smoothness = 1035;
-        biomeParmams.heightOffset = 0;
-        biomeParmams.roughness = 0.75;
-
-        m_biomeNoiseGen.setParameters(biomeParmams);
-    }
+    std::cout << "Seed: " << m_seed << '\n';
+
+    NoiseParameters biomeParmams;
+    biomeParmams.octaves = 5;
+    biomeParmams.amplitude = 120;
+    biomeParmams.smoothness = 1035;
+    biomeParmams.heightOffset = 0;
+    biomeParmams.roughness = 0.75;
+
+    m_biomeNoiseGen.setParameters(biomeParmams);
 }
 
-void ClassicOverWorldGenerator::generateTerrainFor(Chunk &chunk)
+int ClassicOverWorldGenerator::getSeed() const noexcept
 {
-    m_pChunk = &chunk;
+    return m_seed;
+}
 
-    auto location = chunk.getLocation();
-    m_random.setSeed(chunk_seed(location.x, location.y));
+void ClassicOverWorldGenerator::generateStage(ChunkStatus stage, Chunk &chunk) const
+{
+    switch (stage) {
+        case ChunkStatus::Biomes:
+            getBiomeMap(chunk.getLocation());
+            break;
 
-    getBiomeMap();
-    getHeightMap();
+        case ChunkStatus::Heights:
+            getHeightMap(chunk.getLocation());
+            break;
 
-    auto maxHeight = m_heightMap.getMaxValue();
+        case ChunkStatus::Surface:
+            setBlocks(chunk, *getHeightMap(chunk.getLocation()));
+            break;
 
-    maxHeight = std::max(maxHeight, WATER_LEVEL);
-    setBlocks(maxHeight);
+        case ChunkStatus::Decorated: {
+            setStructures(chunk);
+
+            std::unique_lock<std::mutex> lock(statisticsMutex);
+            statistics.chunks++;
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+ChunkStatus ClassicOverWorldGenerator::getNeighbourStage(ChunkStatus stage) const noexcept
+{
+    return stage == ChunkStatus::Decorated ? ChunkStatus::Heights : ChunkStatus::Empty;
 }
 
 int ClassicOverWorldGenerator::getMinimumSpawnHeight() const noexcept
@@ -87,15 +115,23 @@ int ClassicOverWorldGenerator::getMinimumSpawnHeight() const noexcept
     return WATER_LEVEL;
 }
 
-void ClassicOverWorldGenerator::getHeightIn(int xMin, int zMin, int xMax,
-                                            int zMax)
+ClassicOverWorldGenerator::Statistics ClassicOverWorldGenerator::takeStatistics()
+{
+    std::unique_lock<std::mutex> lock(statisticsMutex);
+    Statistics taken = statistics;
+    statistics = {};
+    return taken;
+}
+
+void ClassicOverWorldGenerator::getHeightIn(const sf::Vector2i &location,
+                                            HeightMap &heightMap, int xMin,
+                                            int zMin, int xMax, int zMax) const
 {
 
     auto getHeightAt = [&](int x, int z) {
-        const Biome &biome = getBiome(x, z);
+        const Biome &biome = getBiome(*heightMap.biomeMap, x, z);
 
-        return biome.getHeight(x, z, m_pChunk->getLocation().x,
-                               m_pChunk->getLocation().y);
+        return biome.getHeight(x, z, location.x, location.y);
     };
 
     float bottomLeft = static_cast<float>(getHeightAt(xMin, zMin));
@@ -111,162 +147,176 @@ void ClassicOverWorldGenerator::getHeightIn(int xMin, int zMin, int xMax,
                 static_cast<float>(zMin), static_cast<float>(zMax),
                 static_cast<float>(x), static_cast<float>(z));
 
-            m_heightMap.get(x + CHUNK_SIZE, z + CHUNK_SIZE) = static_cast<int>(h);
+            heightMap.heights.get(x, z) = static_cast<int>(h);
         }
 }
 
-void ClassicOverWorldGenerator::getHeightMap()
+std::shared_ptr<const ClassicOverWorldGenerator::HeightMap>
+ClassicOverWorldGenerator::getHeightMap(const sf::Vector2i &location) const
 {
-    constexpr static auto HALF_CHUNK = CHUNK_SIZE / 2;
-    constexpr static auto CHUNK = CHUNK_SIZE;
-
-    for(int offx = -CHUNK_SIZE; offx <= CHUNK_SIZE; offx += CHUNK_SIZE) {
-        for(int offz = -CHUNK_SIZE; offz <= CHUNK_SIZE; offz += CHUNK_SIZE) {
-            getHeightIn(offx + 0, offz + 0, offx + HALF_CHUNK, offz + HALF_CHUNK);
-            getHeightIn(offx + HALF_CHUNK, offz + 0, offx + CHUNK, offz + HALF_CHUNK);
-            getHeightIn(offx + 0, offz + HALF_CHUNK, offx + HALF_CHUNK, offz + CHUNK);
-            getHeightIn(offx + HALF_CHUNK, offz + HALF_CHUNK, offx + CHUNK, offz + CHUNK);
-        }
-    }
+    return m_heightCache.get(location, [this](const sf::Vector2i &location,
+                                              HeightMap &heightMap) {
+        constexpr static auto HALF_CHUNK = CHUNK_SIZE / 2;
+        constexpr static auto CHUNK = CHUNK_SIZE;
 
+        heightMap.biomeMap = getBiomeMap(location);
+
+        getHeightIn(location, heightMap, 0, 0, HALF_CHUNK, HALF_CHUNK);
+        getHeightIn(location, heightMap, HALF_CHUNK, 0, CHUNK, HALF_CHUNK);
+        getHeightIn(location, heightMap, 0, HALF_CHUNK, HALF_CHUNK, CHUNK);
+        getHeightIn(location, heightMap, HALF_CHUNK, HALF_CHUNK, CHUNK, CHUNK);
+
+        getStructures(location, heightMap);
+
+        // A height sample at each corner of the four quadrants
+        std::unique_lock<std::mutex> lock(statisticsMutex);
+        statistics.heightMaps++;
+        statistics.noiseSamples += 16;
+    });
 }
 
-void ClassicOverWorldGenerator::getBiomeMap()
+std::shared_ptr<const ClassicOverWorldGenerator::BiomeMap>
+ClassicOverWorldGenerator::getBiomeMap(const sf::Vector2i &location) const
 {
-    auto location = m_pChunk->getLocation();
+    return m_biomeCache.get(location, [this](const sf::Vector2i &location,
+                                             BiomeMap &biomeMap) {
+        constexpr int WIDTH = CHUNK_SIZE + 1;
+
+        std::array<double, WIDTH * WIDTH> heights;
+        m_biomeNoiseGen.getHeightGrid((location.x + 10) * CHUNK_SIZE,
+                                      (location.y + 10) * CHUNK_SIZE, WIDTH, WIDTH,
+                                      heights.data());
+
+        for (int x = 0; x < WIDTH; x++)
+            for (int z = 0; z < WIDTH; z++) {
+                biomeMap.biomes.get(x, z) = static_cast<int>(heights[z * WIDTH + x]);
+            }
 
-    for (int x = 0; x < 3*CHUNK_SIZE + 1; x++)
-        for (int z = 0; z < 3*CHUNK_SIZE + 1; z++) {
-            double h = m_biomeNoiseGen.getHeight(x - CHUNK_SIZE, z - CHUNK_SIZE, location.x + 10,
-                                                 location.y + 10);
-            m_biomeMap.get(x, z) = static_cast<int>(h);
-        }
+        // A biome sample per block up to the next chunks
+        std::unique_lock<std::mutex> lock(statisticsMutex);
+        statistics.noiseSamples += (CHUNK_SIZE + 1) * (CHUNK_SIZE + 1);
+    });
 }
 
-void ClassicOverWorldGenerator::getStructures(int offX, int offZ, std::vector<std::pair<sf::Vector3i, Structure*>>& structures)
+void ClassicOverWorldGenerator::getStructures(const sf::Vector2i &location,
+                                              HeightMap &heightMap) const
 {
-    Random<std::minstd_rand> chunk_random;
-    int chunkX = m_pChunk->getLocation().x + offX;
-    int chunkZ = m_pChunk->getLocation().y + offZ;
-    chunk_random.setSeed(chunk_seed(chunkX, chunkZ));
     int block_structure = 0;
 
     for(int x = 0; x < CHUNK_SIZE; x++) {
         for(int z = 0; z < CHUNK_SIZE; z++) {
-            int arrayIdx = x + CHUNK_SIZE + (offX * CHUNK_SIZE);
-            int arrayIdz = z + CHUNK_SIZE + (offZ * CHUNK_SIZE);
-
-            int posX = x + offX * CHUNK_SIZE;
-            int posZ = z + offZ * CHUNK_SIZE;
-
-            int height = m_heightMap.get(arrayIdx, arrayIdz);
-            auto &biome = getBiome(posX, posZ);
+            int height = heightMap.heights.get(x, z);
+            auto &biome = getBiome(*heightMap.biomeMap, x, z);
             int structure;
             int variant;
-            sf::Vector3i pos(posX, height, posZ);
+            sf::Vector3i pos(x, height, z);
 
             if(height <= WATER_LEVEL) continue;
 
-            if(chunk_random.intInRange(0, biome.getTreeFrequency()) == 5) {
-                int tree_type = biome.getTreeType(chunk_random, height);
-                variant = chunk_random.intInRange(0, (int)(this->structures[tree_type].size())-1);
-                structures.emplace_back(pos, &(this->structures[tree_type].data()[variant]));
+            int worldX = location.x * CHUNK_SIZE + x;
+            int worldZ = location.y * CHUNK_SIZE + z;
+            auto tree_random = m_random.at(worldX, height, worldZ, Purpose::Tree);
+
+            if(tree_random.intInRange(0, biome.getTreeFrequency()) == 5) {
+                int tree_type = biome.getTreeType(tree_random, height);
+                variant = tree_random.intInRange(0, (int)(this->structures[tree_type].size())-1);
+                heightMap.structures.emplace_back(
+                    pos, &(this->structures[tree_type].data()[variant]));
             }
             else if(!block_structure) {
-                structure = biome.getStructure(chunk_random, height);
+                auto structure_random =
+                    m_random.at(worldX, height, worldZ, Purpose::Structure);
+                structure = biome.getStructure(structure_random, height);
 
                 if(structure > -1) {
                     block_structure = 1;
-                    variant = chunk_random.intInRange(0, (int)(this->structures[structure].size()-1));
-                    structures.emplace_back(pos, &(this->structures[structure].data()[variant]));
+                    variant = structure_random.intInRange(0, (int)(this->structures[structure].size()-1));
+                    heightMap.structures.emplace_back(
+                        pos, &(this->structures[structure].data()[variant]));
                 }
             }
         }
     }
 }
 
-void ClassicOverWorldGenerator::setBlocks(int maxHeight)
+void ClassicOverWorldGenerator::setBlocks(Chunk &chunk, const HeightMap &heightMap) const
 {
-    std::vector<std::pair<sf::Vector3i, Structure*>> structures;
     std::vector<sf::Vector3i> plants;
+    auto &biomeMap = *heightMap.biomeMap;
+
+    auto location = chunk.getLocation();
 
-    getStructures(-1, -1, structures);
-    getStructures(-1,  0, structures);
-    getStructures(-1,  1, structures);
-    getStructures( 0, -1, structures);
-    getStructures( 0,  0, structures);
-    getStructures( 0,  1, structures);
-    getStructures( 1, -1, structures);
-    getStructures( 1,  0, structures);
-    getStructures( 1,  1, structures);
-
-    for (int y = 0; y < maxHeight + 1; y++)
-        for (int x = 0; x < CHUNK_SIZE; x++)
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                int height = m_heightMap.get(x + CHUNK_SIZE, z + CHUNK_SIZE);
-                auto &biome = getBiome(x, z);
-
-                if (y > height) {
-                    if (y <= WATER_LEVEL) {
-                        m_pChunk->setBlock(x, y, z, BlockId::Water);
-                    }
+    // Below the lowest dirt everything is stone, so whole layers, and often
+    // whole sections, are written in one go
+    int stoneTop = heightMap.heights.getMinValue() - 2;
+    chunk.fillBox(0, 0, 0, CHUNK_SIZE, stoneTop, CHUNK_SIZE, BlockId::Stone);
+
+    for (int x = 0; x < CHUNK_SIZE; x++)
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            int height = heightMap.heights.get(x, z);
+            chunk.fillColumn(x, z, stoneTop, height - 2, BlockId::Stone);
+            chunk.fillColumn(x, z, height - 2, height, BlockId::Dirt);
+            chunk.fillColumn(x, z, height + 1, WATER_LEVEL + 1, BlockId::Water);
+
+            int worldX = location.x * CHUNK_SIZE + x;
+            int worldZ = location.y * CHUNK_SIZE + z;
+            auto random = m_random.at(worldX, height, worldZ, Purpose::Surface);
+            auto &biome = getBiome(biomeMap, x, z);
+
+            if (height >= WATER_LEVEL) {
+                if (height < WATER_LEVEL + 4) {
+                    chunk.setBlock(x, height, z, biome.getBeachBlock(random));
                     continue;
                 }
-                else if (y == height) {
-                    if (y >= WATER_LEVEL) {
-                        if (y < WATER_LEVEL + 4) {
-                            m_pChunk->setBlock(x, y, z,
-                                               biome.getBeachBlock(m_random));
-                            continue;
-                        }
-
-                        if (m_random.intInRange(0, biome.getTreeFrequency()) ==
-                            5) {
-                            //trees.emplace_back(x, y + 1, z);
-                        }
-                        if (m_random.intInRange(0, biome.getPlantFrequency()) ==
-                            5) {
-                            plants.emplace_back(x, y + 1, z);
-                        }
-                        m_pChunk->setBlock(
-                            x, y, z, getBiome(x, z).getTopBlock(m_random));
-                    }
-                    else {
-                        m_pChunk->setBlock(x, y, z,
-                                           biome.getUnderWaterBlock(m_random));
-                    }
-                }
-                else if (y > height - 3) {
-                    m_pChunk->setBlock(x, y, z, BlockId::Dirt);
-                }
-                else {
-                    m_pChunk->setBlock(x, y, z, BlockId::Stone);
+
+                if (random.intInRange(0, biome.getPlantFrequency()) == 5) {
+                    plants.emplace_back(x, height + 1, z);
                 }
+                chunk.setBlock(x, height, z, biome.getTopBlock(random));
+            }
+            else {
+                chunk.setBlock(x, height, z, biome.getUnderWaterBlock(random));
             }
+        }
 
     for (auto &plant : plants) {
         int x = plant.x;
         int z = plant.z;
 
-        auto block = getBiome(x, z).getPlant(m_random);
-        m_pChunk->setBlock(x, plant.y, z, block);
+        auto random = m_random.at(location.x * CHUNK_SIZE + x, plant.y,
+                                  location.y * CHUNK_SIZE + z, Purpose::Plant);
+        auto block = getBiome(biomeMap, x, z).getPlant(random);
+        chunk.setBlock(x, plant.y, z, block);
     }
+}
 
-    for (auto &tree : structures) {
-        tree.second->generate_structure(m_pChunk, tree.first);
-        // int x = tree.x;
-        // int z = tree.z;
+void ClassicOverWorldGenerator::setStructures(Chunk &chunk) const
+{
+    auto location = chunk.getLocation();
 
-        // auto tree_type = getBiome(x, z).getTreeType(m_random, *m_pChunk, x, tree.y, z);
+    // Structures are placed relative to the chunk they grow from
+    for (int dx = -1; dx <= 1; dx++)
+        for (int dz = -1; dz <= 1; dz++) {
+            auto heightMap = getHeightMap({location.x + dx, location.y + dz});
+            sf::Vector3i offset(dx * CHUNK_SIZE, 0, dz * CHUNK_SIZE);
 
-        // int variant_index = m_random.intInRange(0, (int)structures[tree_type].size()-1);
-        // structures[tree_type][variant_index].generate_structure(m_pChunk, tree);
-    }
+            for (auto &tree : heightMap->structures) {
+                tree.second->generate_structure(&chunk, tree.first + offset);
+                // int x = tree.x;
+                // int z = tree.z;
+
+                // auto tree_type = getBiome(x, z).getTreeType(m_random, *m_pChunk, x, tree.y, z);
+
+                // int variant_index = m_random.intInRange(0, (int)structures[tree_type].size()-1);
+                // structures[tree_type][variant_index].generate_structure(m_pChunk, tree);
+            }
+        }
 }
 
-const Biome &ClassicOverWorldGenerator::getBiome(int x, int z) const
+const Biome &ClassicOverWorldGenerator::getBiome(const BiomeMap &biomeMap, int x,
+                                                 int z) const
 {
-    int biomeValue = m_biomeMap.get(x + CHUNK_SIZE, z + CHUNK_SIZE);
+    int biomeValue = biomeMap.biomes.get(x, z);
 
     if (biomeValue > 160) {
         return m_oceanBiome;
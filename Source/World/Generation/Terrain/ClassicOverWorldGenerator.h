@@ -4,7 +4,7 @@
 #include "TerrainGenerator.h"
 
 #include "../../../Util/Array2D.h"
-#include "../../../Util/Random.h"
+#include "../../../Util/PositionRandom.h"
 
 #include "../../../Maths/NoiseGenerator.h"
 #include "../../WorldConstants.h"
@@ -15,8 +15,10 @@
 #include "../Biome/OceanBiome.h"
 #include "../Biome/TemperateForestBiome.h"
 #include <SFML/System/Vector3.hpp>
+#include <memory>
 #include <vector>
 #include "../Structures/Structure.h"
+#include "TerrainCache.h"
 
 class Chunk;
 
@@ -33,24 +35,42 @@ class Chunk;
  * biomes, such as grassland, temperate forest, desert, ocean, and light
  * forest. The generator also provides methods to set up noise parameters
  * and generate terrain for a given chunk.
+ *
+ * The biomes, noise and structures are only read once the generator is
+ * constructed, so one generator can fill many chunks at once. The biomes,
+ * heights and structure placements of each chunk are computed once, by the
+ * Biomes and Heights stages, and kept in TerrainCaches where the later
+ * stages and the neighbouring chunks find them.
  */
 class ClassicOverWorldGenerator : public TerrainGenerator {
   public:
+    /// @brief Creates a generator with a random seed.
     ClassicOverWorldGenerator();
 
+    /// @brief Creates a generator for the given seed, which always generates
+    /// the same terrain.
+    explicit ClassicOverWorldGenerator(int seed);
+
+    int getSeed() const noexcept;
+
     /**
-     * @brief Generates terrain for the specified chunk.
+     * @brief Runs one generation stage for the specified chunk.
      * 
+     * @param stage The stage to run.
      * @param chunk The chunk to generate terrain for.
      * 
      * @details
-     * This method generates terrain for the specified chunk by creating a height
-     * map and biome map. It uses the noise generator to create a height value
-     * based on the chunk location. The method sets the blocks in the chunk
-     * according to the generated height and biome information. It also handles
-     * the placement of trees and plants based on the biome and height values.
+     * The Biomes and Heights stages create a biome map and a height map for
+     * the chunk, using the noise generators and the chunk location. The
+     * Surface stage sets the blocks in the chunk according to the generated
+     * height and biome information, and places plants. The Decorated stage
+     * places the trees and other structures of the chunk and its neighbours.
      */
-    void generateTerrainFor(Chunk &chunk) override;
+    void generateStage(ChunkStatus stage, Chunk &chunk) const override;
+
+    /// @brief Structures grow across chunk borders, so decorating a chunk
+    /// needs the height maps of its neighbours.
+    ChunkStatus getNeighbourStage(ChunkStatus stage) const noexcept override;
     
     /**
      * @brief Gets the minimum spawn height for the terrain generator.
@@ -64,35 +84,66 @@ class ClassicOverWorldGenerator : public TerrainGenerator {
     int getMinimumSpawnHeight() const noexcept override;
     void check_integrity();
 
+    struct Statistics {
+        int chunks = 0;
+        int heightMaps = 0;
+        long long noiseSamples = 0;
+    };
+
+    /// @brief Returns the statistics gathered so far and resets them.
+    static Statistics takeStatistics();
+
+    /// @brief The noise samples one chunk took before the terrain cache.
+    static constexpr int UNCACHED_NOISE_SAMPLES =
+        (3 * CHUNK_SIZE + 1) * (3 * CHUNK_SIZE + 1) + 9 * 16;
+
   private:
-    
-    static void setUpNoise();
+    /// @brief The biome values of a chunk, one wider so the last row and
+    /// column hold the biomes at the start of the next chunks.
+    struct BiomeMap {
+        Array2D<int, CHUNK_SIZE + 1> biomes;
+    };
+
+    /// @brief The heights of a chunk and the structures growing from it.
+    struct HeightMap {
+        std::shared_ptr<const BiomeMap> biomeMap;
+        Array2D<int, CHUNK_SIZE> heights;
+
+        // In the block coordinates of the chunk
+        std::vector<std::pair<sf::Vector3i, const Structure *>> structures;
+    };
+
+    void setUpNoise();
 
     /**
      * @brief Sets the blocks in the chunk based on the height map and biome map.
      * 
-     * @param maxHeight The maximum height value for the chunk.
+     * @param chunk The chunk to set the blocks of.
+     * @param heightMap The height map of the chunk.
      * 
      * @details
      * This method sets the blocks in the chunk based on the height map and
      * biome map. It iterates through the chunk coordinates and sets the
      * appropriate block type based on the height and biome values. It also
-     * handles the placement of trees and plants based on the biome and
-     * height values. The method uses the setBlock method to set the block
-     * type for each coordinate. It also handles the placement of water
-     * blocks and dirt blocks based on the height values. The method
-     * ensures that the blocks are set within the bounds of the chunk size.
-     * It uses the getBiome method to retrieve the biome for each coordinate
-     * and sets the block type accordingly. The method also handles the
-     * placement of trees and plants based on the biome and height values.
-     * It uses the getTree method from the biome class to generate
-     * trees and plants.
+     * handles the placement of plants based on the biome and height values.
+     * The method uses the setBlock method to set the block type for each
+     * coordinate. It also handles the placement of water blocks and dirt
+     * blocks based on the height values. The method ensures that the blocks
+     * are set within the bounds of the chunk size. It uses the getBiome
+     * method to retrieve the biome for each coordinate and sets the block
+     * type accordingly.
      */
-    void setBlocks(int maxHeight);
+    void setBlocks(Chunk &chunk, const HeightMap &heightMap) const;
+
+    /// @brief Places the structures of the chunk and its neighbours that
+    /// reach into the chunk.
+    void setStructures(Chunk &chunk) const;
 
     /**
      * @brief Gets the height in the specified area.
      * 
+     * @param location The chunk the area is in.
+     * @param heightMap The height map to fill.
      * @param xMin The minimum x-coordinate of the area.
      * @param zMin The minimum z-coordinate of the area.
      * @param xMax The maximum x-coordinate of the area.
@@ -106,36 +157,39 @@ class ClassicOverWorldGenerator : public TerrainGenerator {
      * The method ensures that the height values are within the bounds of
      * the chunk size.
      */
-    void getHeightIn(int xMin, int zMin, int xMax, int zMax);
+    void getHeightIn(const sf::Vector2i &location, HeightMap &heightMap,
+                     int xMin, int zMin, int xMax, int zMax) const;
     
     /**
      * @brief Gets the height map for the chunk.
      * 
      * @details
-     * This method generates the height map for the chunk by dividing the
-     * chunk into four quadrants and calculating the height for each quadrant.
-     * It uses the getHeightIn method to calculate the height values for
-     * each quadrant. The height values are stored in the height map.
+     * This method gets the height map of the chunk from the cache, or
+     * generates it by dividing the chunk into four quadrants and calculating
+     * the height for each quadrant. It uses the getHeightIn method to
+     * calculate the height values for each quadrant, and then picks the
+     * structures growing from the chunk.
      */
-    void getHeightMap();
+    std::shared_ptr<const HeightMap> getHeightMap(const sf::Vector2i &location) const;
     
     /**
      * @brief Gets the biome map for the chunk.
      * 
      * @details
-     * This method generates the biome map for the chunk by using the
-     * biome noise generator. It iterates through the chunk coordinates and
-     * retrieves the height value for each coordinate. The height values
-     * are used to determine the biome type for each coordinate. The
-     * biome values are stored in the biome map.
+     * This method gets the biome map of the chunk from the cache, or
+     * generates it by using the biome noise generator. It iterates through
+     * the chunk coordinates and retrieves the height value for each
+     * coordinate. The height values are used to determine the biome type for
+     * each coordinate.
      */
-    void getBiomeMap();
+    std::shared_ptr<const BiomeMap> getBiomeMap(const sf::Vector2i &location) const;
 
     /**<int>
      * @brief Gets the biome for the specified coordinates.
      * 
-     * @param x The x-coordinate of the block.
-     * @param z The z-coordinate of the block.
+     * @param biomeMap The biome map of the chunk.
+     * @param x The x-coordinate of the block, up to CHUNK_SIZE.
+     * @param z The z-coordinate of the block, up to CHUNK_SIZE.
      * 
      * @return The biome at the specified coordinates.
      * 
@@ -149,16 +203,12 @@ class ClassicOverWorldGenerator : public TerrainGenerator {
      * biome map. It uses the getBiome method to retrieve the biome for
      * each coordinate and returns the corresponding biome object.
      */
-    const Biome &getBiome(int x, int z) const;
+    const Biome &getBiome(const BiomeMap &biomeMap, int x, int z) const;
 
-    void getStructures(int chunkX, int chunkZ, std::vector<std::pair<sf::Vector3i, Structure*>>& structures);
+    void getStructures(const sf::Vector2i &location, HeightMap &heightMap) const;
 
-    Array2D<int, 3*CHUNK_SIZE> m_heightMap;
-    Array2D<int, 3*CHUNK_SIZE + 1> m_biomeMap;
-
-    Random<std::minstd_rand> m_random;
-
-    static NoiseGenerator m_biomeNoiseGen;
+    int m_seed;
+    NoiseGenerator m_biomeNoiseGen;
 
     std::vector<std::vector<Structure>> structures;
 
@@ -168,7 +218,14 @@ class ClassicOverWorldGenerator : public TerrainGenerator {
     OceanBiome m_oceanBiome;
     LightForest m_lightForest;
 
-    Chunk *m_pChunk = nullptr;
+    // Every random decision is keyed by the block it is made for, so chunks
+    // come out the same whatever order they are generated in
+    PositionRandom m_random;
+
+    // Only hold results that depend on nothing but the chunk location, so
+    // filling them does not change what the generator produces
+    mutable TerrainCache<BiomeMap> m_biomeCache;
+    mutable TerrainCache<HeightMap> m_heightCache;
 };
 
 #endif // CLASSICOVERWORLDGENERATOR_H_INCLUDED
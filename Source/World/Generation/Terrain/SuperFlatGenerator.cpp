@@ -5,16 +5,15 @@
 #include "../../Chunk/Chunk.h"
 #include "../../WorldConstants.h"
 
-void SuperFlatGenerator::generateTerrainFor(Chunk &chunk)
+void SuperFlatGenerator::generateStage(ChunkStatus stage, Chunk &chunk) const
 {
-    for (int x = 0; x < CHUNK_SIZE; ++x)
-        for (int z = 0; z < CHUNK_SIZE; ++z) {
-            chunk.setBlock(x, 0, z, BlockId::Stone);
-            chunk.setBlock(x, 1, z, BlockId::Dirt);
-            chunk.setBlock(x, 2, z, BlockId::Dirt);
-            chunk.setBlock(x, 3, z, BlockId::Dirt);
-            chunk.setBlock(x, 4, z, BlockId::Grass);
-        }
+    if (stage != ChunkStatus::Surface) {
+        return;
+    }
+
+    chunk.fillLayer(0, BlockId::Stone);
+    chunk.fillBox(0, 1, 0, CHUNK_SIZE, 4, CHUNK_SIZE, BlockId::Dirt);
+    chunk.fillLayer(4, BlockId::Grass);
 }
 
 int SuperFlatGenerator::getMinimumSpawnHeight() const noexcept
@@ -21,16 +21,18 @@
 class SuperFlatGenerator : public TerrainGenerator {
   public:
     /**
-     * @brief Generates terrain for the specified chunk.
+     * @brief Runs one generation stage for the specified chunk.
      * 
+     * @param stage The stage to run.
      * @param chunk The chunk to generate terrain for.
      * 
      * @details
      * This method generates terrain for the specified chunk by creating a flat
      * terrain with a specified block type. It sets the blocks in the chunk
-     * according to the super flat terrain generation rules.
+     * according to the super flat terrain generation rules. All of it is done
+     * in the Surface stage; the other stages have nothing to do.
      */
-    void generateTerrainFor(Chunk &chunk) override;
+    void generateStage(ChunkStatus stage, Chunk &chunk) const override;
 
     /**
      * @brief Gets the minimum spawn height for the super flat terrain generator.
@@ -0,0 +1,95 @@
+#ifndef TERRAINCACHE_H_INCLUDED
+#define TERRAINCACHE_H_INCLUDED
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "../../../Util/NonCopyable.h"
+#include "../../Chunk/FlatChunkMap.h"
+
+/**
+ * @class TerrainCache
+ * @brief A bounded, thread safe cache of data computed for each chunk.
+ *
+ * @details
+ * Generating a chunk needs the heights, biomes and structures of its eight
+ * neighbours as well, because structures reach across chunk borders. Keeping
+ * them here lets neighbouring chunks share that work instead of each
+ * computing the whole 3x3 area again, and lets each generation stage pick up
+ * what the stage before it computed.
+ *
+ * Entries are immutable once filled and handed out as shared pointers, so
+ * they stay valid after being evicted. When the cache grows past its
+ * capacity, the entries not used for the longest time are dropped.
+ *
+ * @tparam T The data kept for each chunk.
+ */
+template <typename T>
+class TerrainCache : public NonCopyable {
+  public:
+    using Fill = std::function<void(const sf::Vector2i &location, T &entry)>;
+
+    /// @param capacity The number of chunks to keep.
+    explicit TerrainCache(std::size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    /**
+     * @brief Gets the entry of a chunk, filling it in if it is not cached.
+     *
+     * @details
+     * The entry is filled without holding the lock, so two threads missing
+     * the same chunk at once may both fill it. Only the first one is kept;
+     * fill must give the same result for the same location.
+     */
+    std::shared_ptr<const T> get(const sf::Vector2i &location, const Fill &fill)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (Slot *slot = m_slots.find(location.x, location.y)) {
+                slot->lastUse = m_uses++;
+                return slot->entry;
+            }
+        }
+
+        auto entry = std::make_shared<T>();
+        fill(location, *entry);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto [slot, isNew] =
+            m_slots.tryEmplace(location.x, location.y, Slot{std::move(entry), 0});
+        slot->lastUse = m_uses++;
+
+        auto kept = slot->entry;
+        if (isNew && m_slots.size() > m_capacity) {
+            evict();
+        }
+        return kept;
+    }
+
+  private:
+    struct Slot {
+        std::shared_ptr<const T> entry;
+        uint64_t lastUse;
+    };
+
+    // Drops the entries not used in the last capacity / 2 lookups. Each lookup
+    // touches one entry, so this always frees at least half of the cache.
+    void evict()
+    {
+        uint64_t oldest = m_uses - m_capacity / 2;
+        m_slots.eraseIf([oldest](const Slot &slot) { return slot.lastUse < oldest; });
+    }
+
+    FlatChunkMap<Slot> m_slots;
+    std::size_t m_capacity;
+    uint64_t m_uses = 0;
+
+    std::mutex m_mutex;
+};
+
+#endif // TERRAINCACHE_H_INCLUDED
@@ -1,6 +1,8 @@
 #ifndef TERRAINGENERATOR_H_INCLUDED
 #define TERRAINGENERATOR_H_INCLUDED
 
+#include "../../Chunk/ChunkStatus.h"
+
 class Chunk;
 
 /**
@@ -11,9 +13,14 @@ class Chunk;
  * The TerrainGenerator class is an abstract base class that defines the
  * interface for terrain generation in the game world. It provides methods
  * for generating terrain for a given chunk and retrieving the minimum spawn
- * height. Derived classes must implement the generateTerrainFor and
+ * height. Derived classes must implement the generateStage and
  * getMinimumSpawnHeight methods to provide specific terrain generation
  * functionality.
+ *
+ * Generation is split into the stages of ChunkStatus, from Biomes to
+ * Decorated. The GenerationPipeline runs each stage as a separate job, once
+ * the chunk has finished the stage before and its neighbours have reached
+ * the stage given by getNeighbourStage.
  */
 class TerrainGenerator {
   public:
@@ -23,11 +30,43 @@ class TerrainGenerator {
      * @param chunk The chunk to generate terrain for.
      * 
      * @details
-     * This method generates terrain for the specified chunk. Derived classes
-     * must implement this method to provide specific terrain generation
-     * functionality.
+     * Runs every stage for the chunk in order, on the calling thread.
+     */
+    void generateTerrainFor(Chunk &chunk) const
+    {
+        for (auto stage = ChunkStatus::Biomes; stage <= ChunkStatus::Decorated;
+             stage = nextStatus(stage)) {
+            generateStage(stage, chunk);
+        }
+    }
+
+    /**
+     * @brief Runs one generation stage for the specified chunk.
+     *
+     * @param stage The stage to run, from Biomes to Decorated.
+     * @param chunk The chunk, which has finished the stage before.
+     *
+     * @details
+     * Chunks are generated on several threads at once, so implementations
+     * must keep any per-chunk state local to the call, or in caches that are
+     * safe to share, and only read from the generator itself. A stage must
+     * give the same result whether or not the neighbours have reached the
+     * stage it depends on; the dependency only lets the work be spread out.
      */
-    virtual void generateTerrainFor(Chunk &chunk) = 0;
+    virtual void generateStage(ChunkStatus stage, Chunk &chunk) const = 0;
+
+    /**
+     * @brief Gets the stage the eight neighbours of a chunk must reach before
+     * the given stage can run for it.
+     *
+     * @return A stage before the given one, or Empty if the stage does not
+     *         depend on the neighbours.
+     */
+    virtual ChunkStatus getNeighbourStage(ChunkStatus) const noexcept
+    {
+        return ChunkStatus::Empty;
+    }
+
     /**
      * @brief Gets the minimum spawn height for the terrain generator.
      * 
@@ -1,26 +1,42 @@
 #include "World.h"
 
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
 #include <future>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
 
 #include "../Camera.h"
-#include "../Input/ToggleKey.h"
 #include "../Maths/Vector2XZ.h"
-#include "../Player/Player.h"
-#include "../Renderer/RenderMaster.h"
 #include "../Util/Random.h"
-
-World::World(const Camera &camera, const Config &config, Player &player)
-    : m_chunkManager(*this)
+#include "../Util/ThreadPool.h"
+#include "Chunk/ChunkAreaLock.h"
+#include "Chunk/ChunkMeshBuilder.h"
+#include "Chunk/SectionSnapshot.h"
+#include "Generation/Terrain/ClassicOverWorldGenerator.h"
+
+namespace {
+// How far the camera moves, in blocks, or turns, in degrees, before the
+// queued chunk jobs are reordered
+constexpr float REFOCUS_DISTANCE = 2.0f;
+constexpr float REFOCUS_ANGLE = 5.0f;
+} // namespace
+
+World::World(const Camera &camera, const Config &config)
+    : m_chunkManager(*this, config)
     , m_renderDistance(config.renderDistance)
+    , m_config(config)
+    , m_meshWorkers(config.meshWorkers > 0 ? config.meshWorkers
+                                           : ThreadPool::getDefaultThreadCount())
 {
     setSpawnPoint();
-    player.setSpawn(m_playerSpawnPoint + (glm::vec3){0.f,1.f,0.f});
-    player.setPosition(m_playerSpawnPoint + (glm::vec3){0.f,1.f,0.f});
+    publishFocus(camera);
 
     for (int i = 0; i < 1; i++) {
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        m_chunkLoadThreads.emplace_back([&]() { loadChunks(camera); });
+        m_chunkLoadThreads.emplace_back([&]() { loadChunks(); });
     }
 }
 
@@ -37,8 +53,14 @@ ChunkBlock World::getBlock(int x, int y, int z)
     auto bp = getBlockXZ(x, z);
     auto chunkPosition = getChunkXZ(x, z);
 
-    return m_chunkManager.getChunk(chunkPosition.x, chunkPosition.z)
-        .getBlock(bp.x, y, bp.z);
+    const Chunk *chunk =
+        m_chunkManager.findChunk(chunkPosition.x, chunkPosition.z);
+    if (!chunk) {
+        return BlockId::Air;
+    }
+
+    std::shared_lock<CountedSharedMutex> lock(chunk->getMutex());
+    return chunk->getBlock(bp.x, y, bp.z);
 }
 
 /**
@@ -53,7 +75,7 @@ ChunkBlock World::getBlock(int x, int y, int z)
  * This function sets a block at the specified world coordinates. It calculates the chunk
  * position and block position within the chunk, and sets the corresponding ChunkBlock.
  * The coordinates are expected to be in world space. If the y-coordinate is less than or
- * equal to 0, the function does nothing.
+ * equal to 0, or the chunk has not loaded, the function does nothing.
  */
 void World::setBlock(int x, int y, int z, ChunkBlock block)
 {
@@ -63,83 +85,145 @@ void World::setBlock(int x, int y, int z, ChunkBlock block)
     auto bp = getBlockXZ(x, z);
     auto chunkPosition = getChunkXZ(x, z);
 
-    m_chunkManager.getChunk(chunkPosition.x, chunkPosition.z)
-        .setBlock(bp.x, y, bp.z, block);
+    // The terrain of a chunk that has not loaded would replace the block
+    Chunk *chunk = m_chunkManager.findChunk(chunkPosition.x, chunkPosition.z);
+    if (chunk && chunk->hasLoaded()) {
+        std::unique_lock<CountedSharedMutex> lock(chunk->getMutex());
+        chunk->setBlock(bp.x, y, bp.z, block);
+    }
 }
 
 
-/// @todo add keyboard to config file
 void World::update(const Camera &camera)
 {
-    static ToggleKey key(sf::Keyboard::C);
-
-    if (key.isKeyPressed()) {
-        std::unique_lock<std::mutex> lock(m_mainMutex);
-        m_chunkManager.deleteMeshes();
-        m_loadDistance = 2;
-    }
-
     for (auto &event : m_events) {
         event->handle(*this);
     }
     m_events.clear();
 
     updateChunks();
+    publishFocus(camera);
+}
+
+void World::deleteMeshes()
+{
+    m_chunkManager.deleteMeshes();
+    m_isMeshScanNeeded = true;
 }
 
-/// @todo Optimize for chunkPositionU usage :thinking: (comment by hopson)
-void World::loadChunks(const Camera &camera)
+void World::publishFocus(const Camera &camera)
 {
+    std::unique_lock<std::mutex> lock(m_focusMutex);
+    m_focus.position = camera.position;
+    m_focus.rotation = camera.rotation;
+    m_focus.frustum = camera.getFrustum();
+}
+
+World::Focus World::getFocus()
+{
+    std::unique_lock<std::mutex> lock(m_focusMutex);
+    return m_focus;
+}
+
+void World::loadChunks()
+{
+    // Where the camera was when the jobs were last reordered
+    glm::vec3 focusPosition(0.0f);
+    glm::vec3 focusRotation(0.0f);
+    sf::Vector2i centre(0, 0);
+    bool isFirstPass = true;
+
     while (m_isRunning) {
-        bool isMeshMade = false;
-        int cameraX = camera.position.x / CHUNK_SIZE;
-        int cameraZ = camera.position.z / CHUNK_SIZE;
-
-        for (int i = 0; i < m_loadDistance; i++) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            int minX = std::max(cameraX - i, 0);
-            int minZ = std::max(cameraZ - i, 0);
-            int maxX = cameraX + i;
-            int maxZ = cameraZ + i;
-
-            for (int x = minX; x < maxX; ++x) {
-                for (int z = minZ; z < maxZ; ++z) {
-                    std::unique_lock<std::mutex> lock(m_mainMutex);
-                    isMeshMade = m_chunkManager.makeMesh(x, z, camera);
-                }
-                // if (isMeshMade)
-                //   break;
-            }
+        // Nothing here holds the map mutex for longer than one chunk, so the
+        // main thread can unload chunks while a whole area is scanned
+        auto loaded = m_chunkManager.loadGeneratedChunks();
+
+        // The camera itself is only read by the main thread, which may be
+        // moving it
+        Focus focus = getFocus();
+        glm::vec3 position = focus.position;
+        bool isRefocused =
+            isFirstPass ||
+            glm::distance(position, focusPosition) > REFOCUS_DISTANCE ||
+            glm::distance(focus.rotation, focusRotation) > REFOCUS_ANGLE;
+        if (isRefocused) {
+            const ViewFrustum &frustum = focus.frustum;
+            m_chunkManager.setFocus(position, frustum);
+            m_meshWorkers.setFocus(position, frustum, m_renderDistance);
+            focusPosition = position;
+            focusRotation = focus.rotation;
+        }
 
-            if (isMeshMade)
-                break;
+        sf::Vector2i cameraChunk((int)position.x / CHUNK_SIZE,
+                                 (int)position.z / CHUNK_SIZE);
+        bool hasCentreMoved = isFirstPass || cameraChunk != centre;
+        if (hasCentreMoved) {
+            centre = cameraChunk;
+            requestChunksAround(centre.x, centre.y);
         }
 
-        if (!isMeshMade) {
-            m_loadDistance++;
+        // A full scan also picks up the sections whose jobs were cancelled
+        // while they were out of range
+        if (hasCentreMoved || m_isMeshScanNeeded.exchange(false)) {
+            for (int x = centre.x - m_renderDistance; x <= centre.x + m_renderDistance; x++)
+                for (int z = centre.y - m_renderDistance;
+                     z <= centre.y + m_renderDistance; z++) {
+                    m_chunkManager.makeMeshes(x, z);
+                }
+        }
+        else {
+            // Each chunk loaded may have been the last neighbour missing
+            for (auto &location : loaded)
+                for (int dx = -1; dx <= 1; dx++)
+                    for (int dz = -1; dz <= 1; dz++) {
+                        m_chunkManager.makeMeshes(location.x + dx, location.y + dz);
+                    }
         }
-        if (m_loadDistance >= m_renderDistance) {
-            m_loadDistance = 2;
+
+        isFirstPass = false;
+        if (loaded.empty() && !isRefocused && !hasCentreMoved) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
         }
     }
 }
 
 void World::updateChunk(int blockX, int blockY, int blockZ)
 {
-    std::unique_lock<std::mutex> lock(m_mainMutex);
-
     auto addChunkToUpdateBatch = [&](const sf::Vector3i &key,
-                                     ChunkSection &section) {
-        m_chunkUpdates.emplace(key, &section);
+                                     ChunkSection *section) {
+        // Neighbouring sections that do not exist hold no faces to rebuild
+        if (section) {
+            m_chunkUpdates.emplace(key, section);
+        }
+    };
+
+    // The sections of a chunk only change with its lock held
+    auto findSection = [&](int x, int y, int z) -> ChunkSection * {
+        const Chunk *chunk = m_chunkManager.findChunk(x, z);
+        if (!chunk) {
+            return nullptr;
+        }
+        std::shared_lock<CountedSharedMutex> lock(chunk->getMutex());
+        return chunk->findSection(y);
     };
 
+    if (blockY < 0 || blockY >= WORLD_HEIGHT) {
+        return;
+    }
+
     auto chunkPosition = getChunkXZ(blockX, blockZ);
     auto chunkSectionY = blockY / CHUNK_SIZE;
 
+    Chunk *chunk = m_chunkManager.findChunk(chunkPosition.x, chunkPosition.z);
+    if (!chunk || !chunk->hasLoaded()) {
+        return;
+    }
+
     sf::Vector3i key(chunkPosition.x, chunkSectionY, chunkPosition.z);
-    addChunkToUpdateBatch(
-        key, m_chunkManager.getChunk(chunkPosition.x, chunkPosition.z)
-                 .getSection(chunkSectionY));
+    {
+        std::unique_lock<CountedSharedMutex> lock(chunk->getMutex());
+        addChunkToUpdateBatch(key, &chunk->getSection(chunkSectionY));
+    }
 
     auto sectionBlockXZ = getBlockXZ(blockX, blockZ);
     auto sectionBlockY = blockY % CHUNK_SIZE;
@@ -149,14 +233,14 @@ void World::updateChunk(int blockX, int blockY, int blockZ)
                             chunkPosition.z);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
     }
     else if (sectionBlockXZ.x == CHUNK_SIZE - 1) {
         sf::Vector3i newKey(chunkPosition.x + 1, chunkSectionY,
                             chunkPosition.z);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
     }
 
     if (sectionBlockY == 0) {
@@ -164,14 +248,14 @@ void World::updateChunk(int blockX, int blockY, int blockZ)
                             chunkPosition.z);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
     }
     else if (sectionBlockY == CHUNK_SIZE - 1) {
         sf::Vector3i newKey(chunkPosition.x, chunkSectionY + 1,
                             chunkPosition.z);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
     }
 
     if (sectionBlockXZ.z == 0) {
@@ -179,51 +263,250 @@ void World::updateChunk(int blockX, int blockY, int blockZ)
                             chunkPosition.z - 1);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
     }
     else if (sectionBlockXZ.z == CHUNK_SIZE - 1) {
         sf::Vector3i newKey(chunkPosition.x, chunkSectionY,
                             chunkPosition.z + 1);
         addChunkToUpdateBatch(
             newKey,
-            m_chunkManager.getChunk(newKey.x, newKey.z).getSection(newKey.y));
+            findSection(newKey.x, newKey.y, newKey.z));
+    }
+}
+
+void World::renderWorld(IChunkRenderer &renderer, const Camera &camera)
+{
+    uploadBuiltMeshes(renderer);
+
+    int cameraX = camera.position.x;
+    int cameraZ = camera.position.z;
+
+    // Drops every chunk further than the unload distance away
+    m_chunkManager.setCentre(cameraX / CHUNK_SIZE, cameraZ / CHUNK_SIZE);
+
+    // Buffering changes the sections, so each chunk is locked exclusively;
+    // this only waits for a mesh being queued in the same chunk
+    m_chunkManager.forEachChunk([&](Chunk &chunk) {
+        std::unique_lock<CountedSharedMutex> lock(chunk.getMutex());
+        chunk.drawChunks(renderer, camera);
+    });
+
+    // Chunks dropped above only hand their buffers over, to be freed here
+    auto &statistics = m_uploadStatistics;
+    statistics.peakWaitingToFree = std::max(statistics.peakWaitingToFree,
+                                            m_chunkManager.getRetiredMeshCount());
+    statistics.freed += m_chunkManager.destroyRetiredMeshes(m_config.meshDeletesPerFrame);
+}
+
+ChunkManager &World::getChunkManager()
+{
+    return m_chunkManager;
+}
+
+const Config &World::getConfig() const
+{
+    return m_config;
+}
+
+const glm::vec3 &World::getPlayerSpawnPoint() const
+{
+    return m_playerSpawnPoint;
+}
+
+void World::queueMesh(ChunkSection &section)
+{
+    auto snapshot = std::make_shared<SectionSnapshot>();
+    snapshot->capture(section);
+
+    unsigned revision = section.startMesh();
+    auto mode = ChunkMeshBuilder::getMode(m_config);
+
+    sf::Vector3i location = section.getLocation();
+
+    m_meshWorkers.push(
+        section.getBounds(),
+        [this, snapshot, revision, mode] {
+            BuiltMesh built{snapshot->getLocation(), revision, {}};
+            ChunkMeshBuilder(*snapshot, built.meshes).buildMesh(mode);
+            m_builtMeshes.push(std::move(built));
+        },
+        [this, location, revision] { cancelMesh(location, revision); });
+}
+
+// Called by the chunk loader, from the mesh workers' setFocus
+void World::cancelMesh(const sf::Vector3i &location, unsigned revision)
+{
+    std::shared_lock<CountedSharedMutex> mapLock(m_chunkManager.getMapMutex());
+    if (Chunk *chunk = m_chunkManager.findStoredChunk(location.x, location.z)) {
+        std::unique_lock<CountedSharedMutex> lock(chunk->getMutex());
+        if (ChunkSection *section = chunk->findSection(location.y)) {
+            section->cancelMesh(revision);
+        }
     }
 }
 
-void World::renderWorld(RenderMaster &renderer, const Camera &camera)
+void World::uploadBuiltMeshes(IChunkRenderer &renderer)
 {
-    std::unique_lock<std::mutex> lock(m_mainMutex);
-    renderer.drawSky();
+    m_builtMeshes.takeAll(m_meshesToUpload);
+
+    // Taken after the meshes, so the chunk of every mesh is in the index
+    m_chunkManager.updateIndex();
 
-    auto &chunkMap = m_chunkManager.getChunks();
-    for (auto itr = chunkMap.begin(); itr != chunkMap.end();) {
-        Chunk &chunk = itr->second;
+    long long byteBudget = m_config.meshUploadKiBPerFrame * 1024LL;
+    float msBudget = m_config.meshUploadMsPerFrame;
+    auto isOverBudget = [&](long long bytes, const sf::Clock &timer) {
+        return (byteBudget > 0 && bytes >= byteBudget) ||
+               (msBudget > 0 && timer.getElapsedTime().asSeconds() * 1000 >= msBudget);
+    };
 
-        int cameraX = camera.position.x;
-        int cameraZ = camera.position.z;
+    auto &statistics = m_uploadStatistics;
+    statistics.peakWaiting =
+        std::max(statistics.peakWaiting, (int)m_meshesToUpload.size());
 
-        int minX = (cameraX / CHUNK_SIZE) - m_renderDistance;
-        int minZ = (cameraZ / CHUNK_SIZE) - m_renderDistance;
-        int maxX = (cameraX / CHUNK_SIZE) + m_renderDistance;
-        int maxZ = (cameraZ / CHUNK_SIZE) + m_renderDistance;
+    sf::Clock timer;
+    long long bytes = 0;
+    bool hasUploaded = false;
+    while (!m_meshesToUpload.empty()) {
+        // At least one mesh is uploaded every frame, however large
+        if (hasUploaded && isOverBudget(bytes, timer)) {
+            statistics.framesOverBudget++;
+            break;
+        }
 
-        auto location = chunk.getLocation();
+        BuiltMesh built = std::move(m_meshesToUpload.front());
+        m_meshesToUpload.pop_front();
 
-        if (minX > location.x || minZ > location.y || maxZ < location.y ||
-            maxX < location.x) {
-            itr = chunkMap.erase(itr);
+        // Sections unloaded since their mesh was queued are no longer found
+        auto &location = built.location;
+        Chunk *chunk = m_chunkManager.findChunk(location.x, location.z);
+        if (!chunk) {
+            statistics.dropped++;
             continue;
         }
-        else {
-            chunk.drawChunks(renderer, camera);
-            itr++;
+
+        std::unique_lock<CountedSharedMutex> lock(chunk->getMutex());
+        ChunkSection *section = chunk->findSection(location.y);
+        auto &meshes = built.meshes;
+        int faces = meshes.solidMesh.faces + meshes.waterMesh.faces +
+                    meshes.floraMesh.faces;
+        if (!section || !section->setMesh(std::move(meshes), built.revision)) {
+            statistics.dropped++;
+            continue;
         }
+
+        section->bufferMesh(renderer);
+        bytes += (long long)faces * ChunkMesh::BYTES_PER_FACE;
+        hasUploaded = true;
+        statistics.uploads++;
     }
+    statistics.bytes += bytes;
 }
 
-ChunkManager &World::getChunkManager()
+void World::requestChunksAround(int x, int z)
 {
-    return m_chunkManager;
+    // The generation pipeline starts with the chunks nearest the camera. The
+    // ring past the render distance is loaded but not meshed, so the chunks
+    // at the edge have every neighbour they are meshed with
+    int loadDistance = m_chunkManager.getLoadDistance();
+    for (int nx = -loadDistance; nx <= loadDistance; nx++)
+        for (int nz = -loadDistance; nz <= loadDistance; nz++) {
+            m_chunkManager.requestChunk(x + nx, z + nz);
+        }
+}
+
+void World::printMeshStatistics()
+{
+    auto statistics = ChunkMeshBuilder::takeStatistics();
+    if (statistics.sections == 0) {
+        std::cout << "No chunk meshes built since the last report\n";
+        return;
+    }
+
+    long long vboBytes = (long long)statistics.faces * ChunkMesh::BYTES_PER_FACE;
+    const char *mode = m_config.greedyMeshing   ? "greedy"
+                       : m_config.columnMeshing ? "columns"
+                                                : "per face";
+
+    std::cout << "Chunk meshes (" << mode << "): " << statistics.sections
+              << " sections, " << statistics.faces * 4 << " vertices, " << vboBytes / 1024
+              << " KiB of buffers, " << vboBytes / statistics.sections
+              << " bytes and "
+              << statistics.buildSeconds * 1000 / statistics.sections
+              << " ms per section\n";
+}
+
+void World::printGenerationStatistics()
+{
+    auto statistics = ClassicOverWorldGenerator::takeStatistics();
+    if (statistics.chunks == 0) {
+        std::cout << "No chunks generated since the last report\n";
+        return;
+    }
+
+    std::cout << "Chunk generation: " << statistics.chunks << " chunks, "
+              << statistics.heightMaps << " height maps computed, "
+              << statistics.noiseSamples / statistics.chunks
+              << " noise samples per chunk ("
+              << ClassicOverWorldGenerator::UNCACHED_NOISE_SAMPLES
+              << " without the terrain cache)\n";
+}
+
+void World::printLockStatistics()
+{
+    auto print = [](const char *name, const LockStatistics::Totals &totals) {
+        std::cout << name << ": " << totals.acquisitions << " taken, "
+                  << totals.contended << " waited for ("
+                  << (totals.acquisitions
+                          ? totals.contended * 100.0 / totals.acquisitions
+                          : 0)
+                  << "%), " << totals.waitSeconds * 1000 << " ms waited in total\n";
+    };
+
+    print("Chunk locks", Chunk::takeLockStatistics());
+    print("Chunk map lock", m_chunkManager.takeMapLockStatistics());
+}
+
+void World::printJobStatistics()
+{
+    auto print = [](const char *name, const ChunkJobScheduler::Statistics &jobs) {
+        std::cout << name << ": " << jobs.started << " started, " << jobs.cancelled
+                  << " cancelled, " << jobs.queued << " waiting, at most "
+                  << jobs.peakQueued << " at once\n";
+    };
+
+    print("Generation jobs", m_chunkManager.takeGenerationStatistics().jobs);
+    print("Mesh jobs", m_meshWorkers.takeStatistics());
+}
+
+void World::printColdCacheStatistics()
+{
+    auto statistics = m_chunkManager.takeColdCacheStatistics();
+    int loads = statistics.hits + statistics.misses;
+
+    std::cout << "Cold chunk cache: " << statistics.hits << " of " << loads
+              << " chunks loaded from the cache ("
+              << (loads ? statistics.hits * 100.0 / loads : 0) << "%), "
+              << statistics.stored << " stored, " << statistics.dropped
+              << " dropped for room; " << statistics.chunks << " chunks in "
+              << statistics.bytes / 1024 << " KiB, "
+              << statistics.uncompressedBytes / 1024
+              << " KiB at a byte per block\n";
+}
+
+void World::printUploadStatistics()
+{
+    auto statistics = m_uploadStatistics;
+    m_uploadStatistics = {};
+    m_uploadStatistics.peakWaiting = (int)m_meshesToUpload.size();
+    m_uploadStatistics.peakWaitingToFree = m_chunkManager.getRetiredMeshCount();
+
+    std::cout << "Mesh uploads: " << statistics.uploads << " meshes, "
+              << statistics.bytes / 1024 << " KiB, " << statistics.dropped
+              << " out of date, " << statistics.framesOverBudget
+              << " frames over budget, at most " << statistics.peakWaiting
+              << " waiting\n"
+              << "Mesh buffers freed: " << statistics.freed << ", at most "
+              << statistics.peakWaitingToFree << " waiting\n";
 }
 
 VectorXZ World::getBlockXZ(int x, int z)
@@ -238,8 +521,15 @@ VectorXZ World::getChunkXZ(int x, int z)
 
 void World::updateChunks()
 {
-    std::unique_lock<std::mutex> lock(m_mainMutex);
     for (auto &c : m_chunkUpdates) {
+        // Chunks are only unloaded by this thread, so the section still exists
+        auto &key = c.first;
+        Chunk *chunk = m_chunkManager.findChunk(key.x, key.z);
+        if (!chunk) {
+            continue;
+        }
+
+        ChunkAreaLock lock(*chunk);
         ChunkSection &s = *c.second;
         s.makeMesh();
     }
@@ -267,6 +557,7 @@ void World::setSpawnPoint()
         blockX = RandomSingleton::get().intInRange(0, 15);
         blockZ = RandomSingleton::get().intInRange(0, 15);
 
+        m_chunkManager.setCentre(chunkX, chunkZ);
         m_chunkManager.loadChunk(chunkX, chunkZ);
         blockY =
             m_chunkManager.getChunk(chunkX, chunkZ).getHeightAt(blockX, blockZ);
@@ -278,9 +569,8 @@ void World::setSpawnPoint()
 
     m_playerSpawnPoint = {worldX, blockY, worldZ};
 
-    for (int x = worldX - 1; x <= worldX + 1; ++x) {
-        for (int z = worldZ - 1; z < worldZ + 1; ++z) {
-            std::unique_lock<std::mutex> lock(m_mainMutex);
+    for (int x = chunkX - 1; x <= chunkX + 1; ++x) {
+        for (int z = chunkZ - 1; z <= chunkZ + 1; ++z) {
             m_chunkManager.loadChunk(x, z);
         }
     };
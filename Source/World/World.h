@@ -2,22 +2,25 @@
 #define WORLD_H_INCLUDED
 
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "../Maths/Frustum.h"
+#include "../Util/MpscQueue.h"
 #include "../Util/NonCopyable.h"
 #include "Chunk/Chunk.h"
+#include "Chunk/ChunkJobScheduler.h"
 #include "Chunk/ChunkManager.h"
 
 #include "Event/IWorldEvent.h"
 
 #include "../Config.h"
 
-class RenderMaster;
 class Camera;
-class Player;
+struct IChunkRenderer;
 
 struct Entity;
 
@@ -30,6 +33,13 @@ struct Entity;
  * unloading chunks, handling block interactions, and rendering the world. It provides
  * methods to get and set blocks, update the world state, and render the world using
  * a RenderMaster object.
+ *
+ * The world is shared by the main thread, which edits and draws it, and the
+ * chunk loader thread, which loads generated chunks and queues meshes. There
+ * is no lock over the whole world: each chunk has its own, see
+ * Chunk::getMutex, and the chunks are looked up without locking, see
+ * ChunkManager. Threads only wait on each other when they use the same
+ * chunk.
  */
 class World : public NonCopyable {
   public:
@@ -38,14 +48,13 @@ class World : public NonCopyable {
      * 
      * @param camera The camera object used for rendering the world.
      * @param config The configuration object containing world settings.
-     * @param player The player object representing the player in the world.
      * 
      * @details
      * This constructor initializes the World object, setting up the chunk manager and
-     * spawning the player at a random location within the world. It also starts a thread
-     * to load chunks around the player.
+     * finding a spawn point for the player at a random location within the world. It
+     * also starts a thread to load chunks around the camera.
      */
-    World(const Camera &camera, const Config &config, Player &player);
+    World(const Camera &camera, const Config &config);
     /**
      * @brief Destructor for the World class.
      * 
@@ -81,11 +90,15 @@ class World : public NonCopyable {
      * 
      * @details
      * This function handles the world update logic, including processing events and
-     * updating the chunk meshes. It also handles a toggle key to reset the chunk meshes
-     * and load distance.
+     * updating the chunk meshes. It also hands the camera's position and frustum
+     * to the chunk loader thread, which never reads the camera itself.
      */
     void update(const Camera &camera);
 
+    /// @brief Deletes every chunk mesh, so they are built again from the
+    /// camera outwards.
+    void deleteMeshes();
+
     /**
      * @brief Updates the chunk at the specified coordinates.
      * 
@@ -101,17 +114,19 @@ class World : public NonCopyable {
     void updateChunk(int blockX, int blockY, int blockZ);
 
     /**
-     * @brief Renders the world using the specified RenderMaster and camera.
+     * @brief Renders the world using the specified renderer and camera.
      * 
-     * @param master The RenderMaster object used for rendering.
+     * @param renderer The renderer that buffers and draws the chunk meshes.
      * @param camera The camera object used for rendering the world.
      * 
      * @details
-     * This function renders the world using the specified RenderMaster and camera. It
-     * handles the rendering of chunks, sky, and other world elements. The camera is used
-     * to determine the view frustum and culling of chunks.
+     * This function hands the chunks in view to the renderer, after
+     * uploading as many of the meshes the workers have finished as the
+     * per-frame budget in the config allows. The buffers of chunks that have
+     * unloaded are freed afterwards, again within a budget. The camera is
+     * used to determine the view frustum and culling of chunks.
      */
-    void renderWorld(RenderMaster &master, const Camera &camera);
+    void renderWorld(IChunkRenderer &renderer, const Camera &camera);
 
     /**
      * @brief Gets the chunk manager for the world.
@@ -125,6 +140,22 @@ class World : public NonCopyable {
      */
     ChunkManager &getChunkManager();
 
+    const Config &getConfig() const;
+
+    /**
+     * @brief Builds the mesh of a section on one of the mesh workers.
+     *
+     * @details
+     * The section is captured right away, so this must be called with a
+     * ChunkAreaLock on its chunk. The finished mesh is uploaded and handed
+     * to the section by renderWorld, within its upload budget.
+     *
+     * Meshes are built nearest the camera first. Those still waiting when
+     * their section falls out of the render distance are cancelled by the
+     * chunk loader, so this must be called on that thread.
+     */
+    void queueMesh(ChunkSection &section);
+
     /**
      * @brief Gets the player spawn point.
      * 
@@ -135,6 +166,9 @@ class World : public NonCopyable {
      * randomly generated within the world bounds and is used to spawn the player when
      * entering the world.
      */
+    const glm::vec3 &getPlayerSpawnPoint() const;
+
+    /// @brief Gets the position of the specified block within its chunk.
     static VectorXZ getBlockXZ(int x, int z);
     /**
      * @brief Gets the chunk coordinates for the specified world coordinates.
@@ -153,6 +187,34 @@ class World : public NonCopyable {
 
     // void collisionTest(Entity &entity);
 
+    /**
+     * @brief Prints the chunk mesh statistics gathered since the last call.
+     *
+     * @details
+     * Calling deleteMeshes first rebuilds every mesh, so the report covers
+     * the whole loaded area.
+     */
+    void printMeshStatistics();
+
+    /// @brief Prints the terrain generation statistics gathered since the last call.
+    void printGenerationStatistics();
+
+    /// @brief Prints how often the chunk locks were waited for since the
+    /// last call.
+    void printLockStatistics();
+
+    /// @brief Prints how many generation and mesh jobs were started and
+    /// cancelled since the last call, and how many are waiting.
+    void printJobStatistics();
+
+    /// @brief Prints how often chunks were loaded from the cache of
+    /// unloaded chunks since the last call, and how much memory it uses.
+    void printColdCacheStatistics();
+
+    /// @brief Prints how much mesh data was uploaded and freed since the
+    /// last call, and how often the upload budget held meshes back.
+    void printUploadStatistics();
+
     template <typename T, typename... Args> void addEvent(Args &&... args)
     {
         m_events.push_back(std::make_unique<T>(std::forward<Args>(args)...));
@@ -162,15 +224,31 @@ class World : public NonCopyable {
     /**
      * @brief Loads chunks around the player based on the camera position.
      * 
-     * @param camera The camera object used to determine the current view.
-     * 
      * @details
-     * This function loads chunks around the player based on the camera position. It
-     * calculates the chunk coordinates based on the camera position and loads the
-     * corresponding chunks. The load distance determines how many chunks are loaded
-     * around the player.
+     * Runs on the chunk loader thread until the world is destroyed, following
+     * the camera as last published by the main thread. Every
+     * chunk within the load distance, one past the render distance, is
+     * requested when the camera enters a new chunk, and the generation and
+     * mesh jobs are reordered whenever it moves or turns far enough.
+     * Sections within the render distance are queued for meshing once their
+     * chunk and its neighbours have loaded, so nothing is rescanned while
+     * the camera stays in the same chunk.
      */
-    void loadChunks(const Camera &camera);
+    void loadChunks();
+
+    /// @brief Where the camera was when the main thread last published it.
+    struct Focus {
+        glm::vec3 position{0.0f};
+        glm::vec3 rotation{0.0f};
+        ViewFrustum frustum;
+    };
+
+    /// @brief Copies the camera for the chunk loader; called by the main
+    /// thread.
+    void publishFocus(const Camera &camera);
+
+    /// @brief Gets the camera last published; called by the chunk loader.
+    Focus getFocus();
 
     /**
      * @brief Updates the chunks based on the current state of the world.
@@ -194,6 +272,39 @@ class World : public NonCopyable {
      */
     void setSpawnPoint();
 
+    /**
+     * @brief Hands the meshes finished by the workers to their sections and
+     * uploads them, oldest first, until the frame's budget is spent.
+     *
+     * @details
+     * Meshes left over wait for the next frame.
+     */
+    void uploadBuiltMeshes(IChunkRenderer &renderer);
+
+    /// @brief Requests the chunks within the load distance of the given
+    /// chunk position; chunks that have loaded are skipped.
+    void requestChunksAround(int x, int z);
+
+    /// @brief Drops a mesh job that was cancelled before it started.
+    void cancelMesh(const sf::Vector3i &location, unsigned revision);
+
+    /// @brief A mesh built by a worker, waiting to be handed to its section.
+    struct BuiltMesh {
+        sf::Vector3i location;
+        unsigned revision;
+        ChunkMeshCollection meshes;
+    };
+
+    struct UploadStatistics {
+        int uploads = 0;
+        int dropped = 0; // Out of date by the time they were taken
+        long long bytes = 0;
+        int framesOverBudget = 0; // Frames that left meshes waiting
+        int peakWaiting = 0;
+        int freed = 0; // Buffers of unloaded chunks
+        int peakWaitingToFree = 0;
+    };
+
     ChunkManager m_chunkManager;
 
     std::vector<std::unique_ptr<IWorldEvent>> m_events;
@@ -202,15 +313,25 @@ class World : public NonCopyable {
     std::atomic<bool> m_isRunning{true};
     std::vector<std::thread> m_chunkLoadThreads;
 
-    // Mutex classes invoked to protect data from shared threads
-
-    std::mutex m_mainMutex;
-    std::mutex m_genMutex;
-
-    int m_loadDistance = 2;
+    // Set when every section needs to be checked for a missing mesh
+    std::atomic<bool> m_isMeshScanNeeded{true};
     const int m_renderDistance;
+    const Config m_config;
+
+    // Written by the main thread every frame, read by the chunk loader
+    std::mutex m_focusMutex;
+    Focus m_focus;
 
     glm::vec3 m_playerSpawnPoint;
+
+    // Pushed to by the mesh workers; the main thread moves them to the
+    // meshes waiting for upload
+    MpscQueue<BuiltMesh> m_builtMeshes;
+    std::deque<BuiltMesh> m_meshesToUpload;
+    UploadStatistics m_uploadStatistics;
+
+    // Declared last so the workers stop before anything they use is destroyed
+    ChunkJobScheduler m_meshWorkers;
 };
 
 #endif // WORLD_H_INCLUDED
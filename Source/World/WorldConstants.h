@@ -6,6 +6,9 @@
 constexpr int CHUNK_SIZE = 16, CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE,
               CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE,
 
+              // Sections in a chunk, and so the blocks in a column
+              CHUNK_SECTIONS = 16, WORLD_HEIGHT = CHUNK_SECTIONS * CHUNK_SIZE,
+
               WATER_LEVEL = 64;
 
 #endif // WORLDCONSTANTS_H_INCLUDED
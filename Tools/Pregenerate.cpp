@@ -0,0 +1,214 @@
+#include "../Source/Util/ThreadPool.h"
+#include "../Source/World/Chunk/Chunk.h"
+#include "../Source/World/Generation/GenerationPipeline.h"
+#include "../Source/World/Generation/Terrain/ClassicOverWorldGenerator.h"
+
+#include <SFML/System/Clock.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * Generates a rectangle of chunks around a centre for a seed, without a
+ * window or GL context, and reports how fast and how much memory it took.
+ *
+ * The chunks go through the same GenerationPipeline and generator as in the
+ * game, on as many workers as asked for, and are kept until the end so the
+ * memory report covers the whole region. Used to measure generation
+ * throughput, and to check a seed's terrain generates before anyone plays it.
+ *
+ * Usage: mc-pregenerate [--seed N] [--centre X Z] [--size WIDTH DEPTH]
+ *                       [--threads N]
+ * Positions and sizes are in chunks. With no seed a random one is used; with
+ * no thread count, all hardware threads but one.
+ */
+
+namespace {
+struct Options {
+    bool hasSeed = false;
+    int seed = 0;
+    int centreX = 0;
+    int centreZ = 0;
+    int width = 32;
+    int depth = 32;
+    int threads = 0;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: mc-pregenerate [--seed N] [--centre X Z] "
+                 "[--size WIDTH DEPTH] [--threads N]\n"
+                 "Run from the repository root, so Res/ is found.\n";
+}
+
+// Throws std::invalid_argument if the options are not understood
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    auto next = [&](int &i) {
+        if (++i >= argc) {
+            throw std::invalid_argument("Missing value");
+        }
+        return std::stoi(argv[i]);
+    };
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--seed") {
+            options.seed = next(i);
+            options.hasSeed = true;
+        }
+        else if (option == "--centre") {
+            options.centreX = next(i);
+            options.centreZ = next(i);
+        }
+        else if (option == "--size") {
+            options.width = next(i);
+            options.depth = next(i);
+        }
+        else if (option == "--threads") {
+            options.threads = next(i);
+        }
+        else {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+
+    if (options.width <= 0 || options.depth <= 0 || options.threads < 0) {
+        throw std::invalid_argument("Sizes must be positive and thread counts not negative");
+    }
+    return options;
+}
+
+const char *getStageName(int stage)
+{
+    static const char *names[GenerationPipeline::NUM_STAGES] = {
+        "Biomes", "Heights", "Surface", "Decorated"};
+    return names[stage];
+}
+
+// The most memory the process has held at once, in bytes
+std::size_t getPeakMemory()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return (std::size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception &e) {
+        std::cout << e.what() << '\n';
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    auto generator = options.hasSeed
+                         ? std::make_unique<ClassicOverWorldGenerator>(options.seed)
+                         : std::make_unique<ClassicOverWorldGenerator>();
+    int threads =
+        options.threads > 0 ? options.threads : ThreadPool::getDefaultThreadCount();
+    GenerationPipeline pipeline(*generator, threads);
+
+    int minX = options.centreX - options.width / 2;
+    int minZ = options.centreZ - options.depth / 2;
+    int total = options.width * options.depth;
+    std::cout << "Generating " << options.width << " x " << options.depth
+              << " chunks around (" << options.centreX << ", "
+              << options.centreZ << ") on " << threads << " threads\n";
+
+    // Rows are requested a few at a time, so the layouts neighbours share
+    // are still in the terrain cache when they are needed
+    int maxWaiting = options.width * 3;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    chunks.reserve(total);
+
+    sf::Clock timer;
+    int requested = 0;
+    int z = minZ;
+    while ((int)chunks.size() < total) {
+        for (auto &chunk : pipeline.takeFinished()) {
+            chunks.push_back(std::move(chunk));
+        }
+
+        bool hasRows = z < minZ + options.depth;
+        if (hasRows && requested - (int)chunks.size() < maxWaiting) {
+            for (int x = minX; x < minX + options.width; x++) {
+                pipeline.request(x, z);
+            }
+            requested += options.width;
+            z++;
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    float seconds = timer.getElapsedTime().asSeconds();
+
+    auto stages = pipeline.takeStatistics();
+    auto terrain = ClassicOverWorldGenerator::takeStatistics();
+
+    std::size_t chunkBytes = 0;
+    for (auto &chunk : chunks) {
+        chunkBytes += chunk->getMemoryUsage();
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << "\nSeed "
+              << generator->getSeed() << ": " << total << " chunks in "
+              << seconds << " s, " << total / seconds << " chunks/s\n\n"
+              << std::setw(10) << "stage" << std::setw(8) << "runs"
+              << std::setw(12) << "total ms" << std::setw(12) << "ms/run"
+              << std::setw(10) << "share" << '\n';
+
+    float workerSeconds = 0;
+    for (float stageSeconds : stages.stageSeconds) {
+        workerSeconds += stageSeconds;
+    }
+    for (int i = 0; i < GenerationPipeline::NUM_STAGES; i++) {
+        int runs = stages.stages[i];
+        float stageSeconds = stages.stageSeconds[i];
+        std::cout << std::setw(10) << getStageName(i) << std::setw(8) << runs
+                  << std::setw(12) << stageSeconds * 1000 << std::setw(12)
+                  << (runs ? stageSeconds * 1000 / runs : 0) << std::setw(9)
+                  << (workerSeconds > 0 ? stageSeconds * 100 / workerSeconds : 0)
+                  << "%\n";
+    }
+
+    std::cout << "\nHeight maps: " << terrain.heightMaps << ", noise samples per chunk: "
+              << (terrain.chunks ? terrain.noiseSamples / terrain.chunks : 0)
+              << "\nPeak stages waiting: " << stages.jobs.peakQueued
+              << "\nChunk memory: " << chunkBytes / 1024 << " KiB, "
+              << chunkBytes / total << " bytes per chunk"
+              << "\nPeak process memory: " << getPeakMemory() / (1024 * 1024)
+              << " MiB\n";
+}